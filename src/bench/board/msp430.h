@@ -0,0 +1,12 @@
+/** \file msp430.h
+ *  \brief The little of the MSP430 frogger touches, for froggerplay:  its
+ *  LED port.
+ */
+
+#ifndef board_msp430_included
+#define board_msp430_included
+
+extern unsigned char P1DIR, P1OUT;
+#define BIT6 0x40
+
+#endif // included
@@ -0,0 +1,14 @@
+/** \file p2switches.h
+ *  \brief p2swLib for froggerplay:  switches read back froggerSwitches,
+ *  which froggerplay sets, one bit per switch, a 0 bit pressed.
+ */
+
+#ifndef board_switches_included
+#define board_switches_included
+
+extern unsigned int froggerSwitches;
+
+static inline void p2sw_init(unsigned char mask) {}
+static inline unsigned int p2sw_read(void) { return froggerSwitches; }
+
+#endif // included
@@ -0,0 +1,129 @@
+/** \file froggerplay.c
+ *  \brief Plays frogger (../frogger/frogger.c) on the simulated LCD.
+ *
+ *  usage: froggerplay [-v] [-s steps] [-d]
+ *
+ *  frogger is built for the host with board/ standing in for its
+ *  libraries.  froggerplay runs its configure, then for steps game steps
+ *  (default 400) its watchdog handler and what its main loop does when
+ *  woken, with the switches pressed and released on a fixed script.
+ *
+ *  After every step that drew, the screen is compared with a layerDraw of
+ *  the same layers from scratch.  Prints the steps drawn, the frogs run
+ *  over, the times the frog got across and a hash of every frame drawn;
+ *  -v also prints each step's frog and cars.  Exits with status 1 at the first step whose screen
+ *  differs.  -d dumps the last frame to frogger.ppm.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lcdutils.h"
+#include "lcdhost.h"
+#include "shape.h"
+
+/* frogger's, see ../frogger/frogger.c */
+extern Layer frogLayer, carPool[];
+extern MovLayer *movLayers;
+extern u_char carCount, frogPosInd_x, frogPosInd_y;
+extern int redrawScreen;
+extern char stepDue;
+void configure();
+void wdt_c_handler();
+char gameStep();
+
+#define LAST_LANE 6		/* frogger's LANES - 1 */
+
+/* board/ */
+unsigned char P1DIR, P1OUT;
+unsigned int froggerSwitches = 0x0f;
+
+/* FNV-1a over the pixels of the screen, continuing from hash */
+static unsigned long
+hashScreen(unsigned long hash)
+{
+  int col, row, i;
+  for (row = 0; row < screenHeight; row++) {
+    for (col = 0; col < screenWidth; col++) {
+      unsigned long pixel = lcdHost_pixel(col, row);
+      for (i = 0; i < 3; i++, pixel >>= 8) {
+	hash ^= pixel & 0xff;
+	hash = (hash * 16777619) & 0xffffffff;
+      }
+    }
+  }
+  return hash;
+}
+
+/* Switches held down during step:  down every twelfth step, right every
+ * seventh and left every thirteenth, released in between
+ */
+static unsigned int
+scriptSwitches(int step)
+{
+  unsigned int pressed = 0;
+  if (step % 12 == 0) pressed |= 4;
+  if (step % 7 == 0) pressed |= 8;
+  if (step % 13 == 0) pressed |= 1;
+  return 0x0f & ~pressed;
+}
+
+int
+main(int argc, char **argv)
+{
+  int steps = 400, verbose = 0, dump = 0;
+  int step, drawn = 0, lost = 0, won = 0, i;
+  unsigned long hash = 2166136261UL;
+
+  for (i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-v"))
+      verbose = 1;
+    else if (!strcmp(argv[i], "-d"))
+      dump = 1;
+    else if (!strcmp(argv[i], "-s") && i + 1 < argc)
+      steps = atoi(argv[++i]);
+    else {
+      fprintf(stderr, "usage: froggerplay [-v] [-s steps] [-d]\n");
+      return 2;
+    }
+  }
+
+  configure();
+  for (step = 0; step < steps; step++) {
+    u_char lane = frogPosInd_y;
+    froggerSwitches = scriptSwitches(step);
+    while (!redrawScreen)	/* ticks until the step is due */
+      wdt_c_handler();
+    redrawScreen = 0;		/* main, woken */
+    if (!stepDue)
+      continue;
+    stepDue = 0;
+    if (gameStep()) {
+      unsigned long drawnHash, fullHash;
+      movLayerDraw(movLayers, &frogLayer);
+      drawnHash = hashScreen(2166136261UL);
+      layerDraw(&frogLayer);
+      fullHash = hashScreen(2166136261UL);
+      if (drawnHash != fullHash) {
+	printf("step %d: screen differs from layerDraw\n", step);
+	return 1;
+      }
+      hash = hashScreen(hash);
+      drawn++;
+    }
+    if (lane && frogPosInd_y == 0) /* the script never hops up */
+      lost++;
+    if (frogPosInd_y == LAST_LANE && lane != LAST_LANE)
+      won++;
+    if (verbose) {
+      printf("%4d frog %d,%d cars", step, frogPosInd_x, frogPosInd_y);
+      for (i = 0; i < carCount; i++)
+	printf(" %d", carPool[i].pos.axes[0]);
+      putchar('\n');
+    }
+  }
+  printf("%d steps, %d drawn, %d lost, %d won, hash %08lx\n", steps, drawn, lost, won, hash);
+  if (dump)
+    lcdHost_dump("frogger.ppm");
+  return 0;
+}
@@ -0,0 +1,203 @@
+/** \file golden.c
+ *  \brief Checks that every drawing method draws the reference frames.
+ *
+ *  usage: golden [-v] [-f frames] [-n count] [scene...]
+ *
+ *  Each scene is played for frames frames with the reference method,
+ *  probe:  layerProbe for every pixel of the screen, so a pixel takes the
+ *  color of the first layer containing it, or bgColor.  Then every other
+ *  method plays the scene again and its screen is compared after each
+ *  frame.  Incremental methods start from a layerDraw of the first frame.
+ *
+ *  Prints a line per scene and method with a hash of all its frames and
+ *  "ok" or the first pixel that differs; -v also prints every frame's
+ *  hash.  Exits with status 1 if any method differs.
+ *
+ *  Before that every layer's abShapeRowSpans is checked against
+ *  abShapeCheck on every row of its bounds (and the rows and columns
+ *  around them) in each frame, so the span drawing methods are known to
+ *  cover the pixels probe does.  Rows the shape leaves to be probed (-1)
+ *  are skipped.
+ *
+ *  Built with LCD_TX_IRQ (golden-irq) it runs on the interrupt driven
+ *  lcdLib, every other method with interrupts off, and must print what
+ *  golden does.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lcdutils.h"
+#include "lcdhost.h"
+#include "shape.h"
+#include "scenes.h"
+
+#define FRAME_PIXELS (screenWidth * screenHeight)
+
+static int verbose;
+static unsigned long *reference; /* frames of the reference method */
+
+/* FNV-1a over the pixels of the screen, continuing from hash */
+static unsigned long
+hashScreen(unsigned long hash)
+{
+  int col, row, i;
+  for (row = 0; row < screenHeight; row++) {
+    for (col = 0; col < screenWidth; col++) {
+      unsigned long pixel = lcdHost_pixel(col, row);
+      for (i = 0; i < 3; i++, pixel >>= 8) {
+	hash ^= pixel & 0xff;
+	hash = (hash * 16777619) & 0xffffffff;
+      }
+    }
+  }
+  return hash;
+}
+
+/* Checks that the spans of layer's shape at its next position cover
+ * exactly the pixels abShapeCheck does.  Returns 0 if they do.
+ */
+static int
+checkLayerSpans(const Scene *scene, int frame, int index, const Layer *layer)
+{
+  Span spans[SHAPE_MAX_SPANS];
+  Region bounds;
+  Vec2 pixel;
+  int n, i, start, end, inSpan;
+
+  abShapeGetBounds(layer->abShape, &layer->posNext, &bounds);
+  for (pixel.axes[1] = bounds.topLeft.axes[1] - 1;
+       pixel.axes[1] <= bounds.botRight.axes[1] + 1; pixel.axes[1]++) {
+    n = abShapeRowSpans(layer->abShape, &layer->posNext, pixel.axes[1], spans);
+    if (n < 0)
+      continue;
+    start = bounds.topLeft.axes[0] - 1;
+    end = bounds.botRight.axes[0] + 1;
+    for (i = 0; i < n; i++) {	/* spans past the bounds are checked too */
+      if (spans[i].start < start) start = spans[i].start;
+      if (spans[i].end > end) end = spans[i].end;
+    }
+    for (pixel.axes[0] = start; pixel.axes[0] <= end; pixel.axes[0]++) {
+      for (inSpan = i = 0; i < n; i++)
+	inSpan |= spans[i].start <= pixel.axes[0] && pixel.axes[0] <= spans[i].end;
+      if (inSpan != abShapeCheck(layer->abShape, &layer->posNext, &pixel)) {
+	printf("%-11s rows    frame %d layer %d pixel (%d,%d) is %s, abShapeCheck says %s\n",
+	       scene->name, frame, index, pixel.axes[0], pixel.axes[1],
+	       inSpan ? "in a span" : "in no span", inSpan ? "out" : "in");
+	return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+/* Checks the spans of every layer of scene over frames frames.  Returns 0
+ * if they all match.
+ */
+static int
+checkSpans(const Scene *scene, int frames, int count)
+{
+  int f, i;
+
+  sceneBuild(scene, count);
+  for (f = 0; f < frames; f++) {
+    if (f)
+      sceneAdvance(scene, f - 1);
+    for (i = 0; i < sceneLayerCount; i++)
+      if (checkLayerSpans(scene, f, i, &sceneLayers[i]))
+	return 1;
+  }
+  printf("%-11s rows    %4d %8s ok\n", scene->name, frames, "");
+  return 0;
+}
+
+/* Plays scene with method.  Keeps its frames if keep, else compares them
+ * with the reference.  Returns 0 if they match.
+ */
+static int
+play(const Scene *scene, const Method *method, int frames, int count, int keep)
+{
+  unsigned long hash = 2166136261;
+  int f, col, row;
+  Layer *layers;
+
+#ifdef LCD_TX_IRQ
+  lcdHost_gie = !lcdHost_gie;	/* queue sent by the interrupt, or not */
+#endif
+  lcd_init();
+  layers = sceneBuild(scene, count);
+  for (f = 0; f < frames; f++) {
+    unsigned long *frame = reference + (long)f * FRAME_PIXELS;
+    if (f)
+      sceneAdvance(scene, f - 1);
+    if (f || method->wholeScreen)
+      method->draw(layers);
+    else
+      layerDraw(layers);	/* incremental methods start from the screen */
+    hash = hashScreen(hash);
+    if (verbose)
+      printf("  %-11s %-7s frame %3d %08lx\n", scene->name, method->name, f, hash);
+    for (row = 0; row < screenHeight; row++) {
+      for (col = 0; col < screenWidth; col++, frame++) {
+	unsigned long pixel = lcdHost_pixel(col, row);
+	if (keep)
+	  *frame = pixel;
+	else if (*frame != pixel) {
+	  printf("%-11s %-7s %4d %08lx frame %d pixel (%d,%d) is %06lx, expected %06lx\n",
+		 scene->name, method->name, frames, hash, f, col, row, pixel, *frame);
+	  return 1;
+	}
+      }
+    }
+  }
+  printf("%-11s %-7s %4d %08lx %s\n", scene->name, method->name, frames, hash,
+	 keep ? "reference" : "ok");
+  return 0;
+}
+
+static void
+usage()
+{
+  int i;
+  fprintf(stderr, "usage: golden [-v] [-f frames] [-n count] [scene...]\nscenes:");
+  for (i = 0; i < sceneCount; i++)
+    fprintf(stderr, " %s", scenes[i].name);
+  fprintf(stderr, "\n");
+  exit(2);
+}
+
+int
+main(int argc, char **argv)
+{
+  int frames = 64, count = 8, failed = 0, i, j, arg;
+
+  for (arg = 1; arg < argc && argv[arg][0] == '-'; arg++) {
+    if (!strcmp(argv[arg], "-v"))
+      verbose = 1;
+    else if (!strcmp(argv[arg], "-f") && arg + 1 < argc)
+      frames = atoi(argv[++arg]);
+    else if (!strcmp(argv[arg], "-n") && arg + 1 < argc)
+      count = atoi(argv[++arg]);
+    else
+      usage();
+  }
+  if (frames < 1 || count < 1)
+    usage();
+  reference = malloc(sizeof *reference * FRAME_PIXELS * frames);
+  if (!reference) {
+    fprintf(stderr, "golden: no room for %d frames\n", frames);
+    return 2;
+  }
+
+  for (i = 0; i < sceneCount; i++) {
+    if (!sceneNamed(&scenes[i], argv + arg, argc - arg))
+      continue;
+    failed |= checkSpans(&scenes[i], frames, count);
+    play(&scenes[i], &methods[0], frames, count, 1);
+    for (j = 1; j < methodCount; j++)
+      if (sceneMethod(&scenes[i], &methods[j]))
+	failed |= play(&scenes[i], &methods[j], frames, count, 0);
+  }
+  free(reference);
+  return failed;
+}
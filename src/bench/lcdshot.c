@@ -0,0 +1,39 @@
+/** \file lcdshot.c
+ *  \brief Draws lcddemo's screen on the simulated LCD, dumps it to
+ *  lcdshot.ppm and prints the traffic it took.
+ */
+
+#include <stdio.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "lcdhost.h"
+
+static void
+printStats(const char *name, const LcdHostStats *stats)
+{
+  printf("%-8s command bytes %6lu  data bytes %6lu  pixels %6lu  setAreas %4lu\n",
+	 name, stats->commandBytes, stats->dataBytes, stats->pixels, stats->setAreas);
+}
+
+int
+main()
+{
+  LcdHostStats stats;
+  lcd_init();
+  lcdHost_frame(0);		/* don't count initialization */
+
+  clearScreen(COLOR_BLUE);
+  lcdHost_frame(&stats);
+  printStats("clear", &stats);
+
+  drawString5x7(20,20, "hello", COLOR_GREEN, COLOR_RED);
+  fillRectangle(30,30, 60, 60, COLOR_ORANGE);
+  lcdHost_frame(&stats);
+  printStats("draw", &stats);
+
+  if (lcdHost_dump("lcdshot.ppm")) {
+    perror("lcdshot.ppm");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,512 @@
+/** \file scenes.c
+ *  \brief Scenes and drawing methods for the host tools (see scenes.h)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "shape.h"
+#include "abCircle.h"
+#include "chordVec.h"
+#include "scenes.h"
+
+u_int bgColor = COLOR_BLACK;
+
+Layer sceneLayers[SCENE_LAYERS];
+int sceneLayerCount;
+
+static Vec2 velocity[SCENE_LAYERS]; /* of sceneLayers[i], zero if it stays */
+static MovLayer movLayers[SCENE_LAYERS]; /* the layers that aren't static */
+
+static unsigned long seed;
+
+/* Stable pseudo random number in [0, n) */
+static int
+sceneRandom(int n)
+{
+  seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+  return (seed >> 16) % n;
+}
+
+static const u_int sceneColors[] = {
+  COLOR_RED, COLOR_GREEN, COLOR_BLUE, COLOR_YELLOW, COLOR_CYAN,
+  COLOR_MAGENTA, COLOR_ORANGE, COLOR_WHITE, COLOR_PINK, COLOR_GRAY,
+};
+
+#define randomColor() (sceneColors[sceneRandom(sizeof sceneColors / sizeof sceneColors[0])])
+#define randomOf(shapes) (&shapes[sceneRandom(sizeof shapes / sizeof shapes[0])])
+
+/* Appends a layer below those added before */
+static Layer *
+addLayer(const void *shape, int col, int row, u_int color,
+	 int dCol, int dRow, u_char flags)
+{
+  Layer *l = &sceneLayers[sceneLayerCount];
+  if (sceneLayerCount == SCENE_LAYERS) {
+    fprintf(stderr, "scenes: more than %d layers\n", SCENE_LAYERS);
+    exit(1);
+  }
+  l->abShape = (AbShape *)shape;
+  l->pos.axes[0] = col;
+  l->pos.axes[1] = row;
+  l->posLast = l->posNext = l->pos; /* layerInit skips static layers */
+  l->color = color;
+  l->next = 0;
+  l->flags = flags;
+  velocity[sceneLayerCount].axes[0] = dCol;
+  velocity[sceneLayerCount].axes[1] = dRow;
+  if (sceneLayerCount)
+    sceneLayers[sceneLayerCount-1].next = l;
+  sceneLayerCount++;
+  return l;
+}
+
+/* Moves layers by their velocity, bouncing off the edges of fence.
+ * Some shapes clip their bounds to the screen, so the extents are
+ * taken with the shape centered on screen and offset from there.
+ */
+static void
+bounceWithin(const Region *fence)
+{
+  static const Vec2 mid = {{screenWidth/2, screenHeight/2}};
+  int i, axis;
+  for (i = 0; i < sceneLayerCount; i++) {
+    Layer *l = &sceneLayers[i];
+    Region extent;
+    Vec2 next;
+    if (!velocity[i].axes[0] && !velocity[i].axes[1])
+      continue;
+    vec2Add(&next, &l->posNext, &velocity[i]);
+    abShapeGetBounds(l->abShape, &mid, &extent);
+    for (axis = 0; axis < 2; axis++) {
+      int shift = next.axes[axis] - mid.axes[axis];
+      if (extent.topLeft.axes[axis] + shift < fence->topLeft.axes[axis] ||
+	  extent.botRight.axes[axis] + shift > fence->botRight.axes[axis]) {
+	velocity[i].axes[axis] = -velocity[i].axes[axis];
+	next.axes[axis] = l->posNext.axes[axis] + velocity[i].axes[axis];
+      }
+    }
+    l->posNext = next;
+  }
+}
+
+static void
+advanceBounce(int frame)
+{
+  Region screen = {{{0, 0}}, {{screenWidth-1, screenHeight-1}}};
+  (void)frame;
+  bounceWithin(&screen);
+}
+
+/** frogger:  frogger.c's lanes, three cars and the frog */
+
+static AbRect laneShape = {abRectGetBounds, abRectCheck, abRectRowSpans, {{screenWidth/2, screenHeight/14}}};
+static AbRArrow carShape = {abRArrowGetBounds, abRArrowCheck, abRArrowRowSpans, screenHeight/7};
+static const u_char laneRows[7] = {17, 39, 61, 83, 105, 127, 149};
+
+static void
+buildFrogger(int count)
+{
+  static const u_int carColors[3] = {COLOR_RED, COLOR_ORANGE, COLOR_BLUE};
+  static const int carSpeeds[3] = {4, 2, 3};
+  int i;
+  (void)count;
+  bgColor = COLOR_BLACK;
+  addLayer(&circle6, 64, laneRows[0], COLOR_GREEN, 0, 0, 0);
+  for (i = 0; i < 3; i++)
+    addLayer(&carShape, 0, laneRows[5 - 2*i], carColors[i], carSpeeds[i], 0, 0);
+  for (i = 5; i >= 1; i -= 2)
+    addLayer(&laneShape, 64, laneRows[i], COLOR_BLACK, 0, 0, LAYER_STATIC);
+  for (i = 6; i >= 0; i -= 2)
+    addLayer(&laneShape, 64, laneRows[i], COLOR_PURPLE, 0, 0, LAYER_STATIC);
+}
+
+/* The same layers, known at compile time */
+#define FROGGER_LAYERS(LAYER)						\
+  LAYER(abCircle, circle6, sceneLayers[0])				\
+  LAYER(abRArrow, carShape, sceneLayers[1])				\
+  LAYER(abRArrow, carShape, sceneLayers[2])				\
+  LAYER(abRArrow, carShape, sceneLayers[3])				\
+  LAYER(abRect, laneShape, sceneLayers[4])				\
+  LAYER(abRect, laneShape, sceneLayers[5])				\
+  LAYER(abRect, laneShape, sceneLayers[6])				\
+  LAYER(abRect, laneShape, sceneLayers[7])				\
+  LAYER(abRect, laneShape, sceneLayers[8])				\
+  LAYER(abRect, laneShape, sceneLayers[9])				\
+  LAYER(abRect, laneShape, sceneLayers[10])
+
+static LAYER_STATIC_PROBE(probeFrogger, FROGGER_LAYERS)
+
+/* Cars wrap around to the left, the frog hops a lane every 8 frames */
+static void
+advanceFrogger(int frame)
+{
+  int i;
+  for (i = 1; i <= 3; i++) {
+    Layer *car = &sceneLayers[i];
+    Region bounds;
+    Vec2 next;
+    vec2Add(&next, &car->posNext, &velocity[i]);
+    abShapeGetBounds(car->abShape, &next, &bounds);
+    if (bounds.botRight.axes[0] >= screenWidth) {
+      next.axes[0] = -carShape.size;
+      car->flags |= LAYER_TELEPORT;
+    }
+    car->posNext = next;
+  }
+  if (frame % 8 == 7) {
+    sceneLayers[0].posNext.axes[1] = laneRows[(frame / 8 + 1) % 7];
+    sceneLayers[0].flags |= LAYER_TELEPORT;
+  }
+}
+
+/** circledemo:  circledemo.c's circle over a square, the square moving */
+
+static AbRect rect10 = {abRectGetBounds, abRectCheck, abRectRowSpans, {{10, 10}}};
+
+static void
+buildCircleDemo(int count)
+{
+  (void)count;
+  bgColor = COLOR_BLUE;
+  addLayer(&circle14, screenWidth/2 + 10, screenHeight/2 + 5, COLOR_ORANGE, 0, 0, 0);
+  addLayer(&rect10, screenWidth/2, screenHeight/2, COLOR_RED, 2, 1, 0);
+}
+
+#define CIRCLE_DEMO_LAYERS(LAYER)					\
+  LAYER(abCircle, circle14, sceneLayers[0])				\
+  LAYER(abRect, rect10, sceneLayers[1])
+
+static LAYER_STATIC_PROBE(probeCircleDemo, CIRCLE_DEMO_LAYERS)
+
+/** shape-motion-demo:  the layers shape-motion-demo.c links together (the
+ *  file doesn't build), cars bouncing within its playing field
+ */
+
+static AbRect demoLaneShape = {abRectGetBounds, abRectCheck, abRectRowSpans, {{screenWidth, screenHeight/7}}};
+static AbRArrow demoCarShape = {abRArrowGetBounds, abRArrowCheck, abRArrowRowSpans, screenHeight/7};
+static AbRectOutline fieldOutline = {
+  abRectOutlineGetBounds, abRectOutlineCheck, abRectOutlineRowSpans,
+  {{screenWidth/2 - 10, screenHeight/2 - 10}}
+};
+
+static void
+buildShapeMotionDemo(int count)
+{
+  int i;
+  (void)count;
+  bgColor = COLOR_BLACK;
+  addLayer(&circle10, 64, 17, COLOR_GREEN, 0, 0, 0);
+  addLayer(&demoCarShape, 20, 127, COLOR_RED, 4, 0, 0);
+  addLayer(&demoCarShape, 20, 83, COLOR_ORANGE, 1, 0, 0);
+  addLayer(&demoCarShape, 20, 39, COLOR_BLUE, 3, 0, 0);
+  addLayer(&demoLaneShape, 64, 39, COLOR_BLACK, 0, 0, 0);
+  for (i = 3; i >= 0; i--)
+    addLayer(&demoLaneShape, 64, 17 + 44*i, COLOR_PURPLE, 0, 0, 0);
+  addLayer(&fieldOutline, screenWidth/2, screenHeight/2, COLOR_WHITE, 0, 0, 0);
+}
+
+static void
+advanceShapeMotionDemo(int frame)
+{
+  Region fence;
+  (void)frame;
+  abShapeGetBounds((AbShape *)&fieldOutline, &sceneLayers[sceneLayerCount-1].pos, &fence);
+  bounceWithin(&fence);
+}
+
+/** rects:  count random rectangles, one of them moving */
+
+static AbRect rectShapes[] = {
+  {abRectGetBounds, abRectCheck, abRectRowSpans, {{3, 3}}},
+  {abRectGetBounds, abRectCheck, abRectRowSpans, {{8, 4}}},
+  {abRectGetBounds, abRectCheck, abRectRowSpans, {{5, 12}}},
+  {abRectGetBounds, abRectCheck, abRectRowSpans, {{15, 10}}},
+  {abRectGetBounds, abRectOutlineCheck, abRectOutlineRowSpans, {{10, 10}}},
+};
+
+static void
+buildRects(int count)
+{
+  int i;
+  bgColor = COLOR_BLUE;
+  for (i = 0; i < count; i++)
+    addLayer(randomOf(rectShapes), 20 + sceneRandom(88), 20 + sceneRandom(120),
+	     randomColor(), i ? 0 : 2, i ? 0 : 1, 0);
+}
+
+/** circles:  count moving circles of circleLib */
+
+static const AbCircle *circleShapes[] = {
+  &circle3, &circle6, &circle10, &circle14, &circle20,
+};
+
+static void
+buildCircles(int count)
+{
+  int i;
+  bgColor = COLOR_BLACK;
+  for (i = 0; i < count; i++)
+    addLayer(*randomOf(circleShapes), 25 + sceneRandom(78), 25 + sceneRandom(110),
+	     randomColor(), 1 + sceneRandom(3), sceneRandom(3) - 1, 0);
+}
+
+/** rings:  count moving circle outlines, some over filled circles */
+
+static const AbCircleOutline ringShapes[] = {
+  {abCircleGetBounds, abCircleOutlineCheck, abCircleOutlineRowSpans, chordVec3, 3},
+  {abCircleGetBounds, abCircleOutlineCheck, abCircleOutlineRowSpans, chordVec8, 8},
+  {abCircleGetBounds, abCircleOutlineCheck, abCircleOutlineRowSpans, chordVec15, 15},
+  {abCircleGetBounds, abCircleOutlineCheck, abCircleOutlineRowSpans, chordVec24, 24},
+};
+
+static void
+buildRings(int count)
+{
+  int i;
+  bgColor = COLOR_BLACK;
+  for (i = 0; i < count; i++)
+    addLayer(randomOf(ringShapes), 25 + sceneRandom(78), 25 + sceneRandom(110),
+	     randomColor(), 1 + sceneRandom(3), sceneRandom(3) - 1, 0);
+  for (i = 0; i < count / 2; i++)
+    addLayer(*randomOf(circleShapes), 25 + sceneRandom(78), 25 + sceneRandom(110),
+	     randomColor(), sceneRandom(3) - 1, 1 + sceneRandom(2), 0);
+}
+
+/** arrows:  count moving arrows */
+
+static AbRArrow arrowShapes[] = {
+  {abRArrowGetBounds, abRArrowCheck, abRArrowRowSpans, 10},
+  {abRArrowGetBounds, abRArrowCheck, abRArrowRowSpans, 20},
+  {abRArrowGetBounds, abRArrowCheck, abRArrowRowSpans, 30},
+};
+
+static void
+buildArrows(int count)
+{
+  int i;
+  bgColor = COLOR_BLACK;
+  for (i = 0; i < count; i++)
+    addLayer(randomOf(arrowShapes), 35 + sceneRandom(60), 20 + sceneRandom(120),
+	     randomColor(), 1 + sceneRandom(2), sceneRandom(5) - 2, 0);
+}
+
+/** masks:  the arrows scene with each arrow shape rasterized to an AbMask,
+ *  so it draws the same frames as arrows
+ */
+
+#define ARROW_SHAPES (sizeof arrowShapes / sizeof arrowShapes[0])
+
+static AbMask arrowMasks[ARROW_SHAPES];
+static u_char arrowMaskBits[ARROW_SHAPES][ABMASK_BYTES(31, 31)];
+
+static void
+buildMasks(int count)
+{
+  int i;
+  for (i = 0; i < (int)ARROW_SHAPES; i++)
+    if (abMaskInit(&arrowMasks[i], (AbShape *)&arrowShapes[i],
+		   arrowMaskBits[i], sizeof arrowMaskBits[i]) < 0) {
+      fprintf(stderr, "scenes: arrow %d too large for its mask\n", i);
+      exit(1);
+    }
+  bgColor = COLOR_BLACK;
+  for (i = 0; i < count; i++)
+    addLayer(randomOf(arrowMasks), 35 + sceneRandom(60), 20 + sceneRandom(120),
+	     randomColor(), 1 + sceneRandom(2), sceneRandom(5) - 2, 0);
+}
+
+/** movers:  4 * count small moving rectangles over static stripes */
+
+static AbRect moverShape = {abRectGetBounds, abRectCheck, abRectRowSpans, {{3, 2}}};
+static AbRect stripeShape = {abRectGetBounds, abRectCheck, abRectRowSpans, {{screenWidth/2, 8}}};
+
+static void
+buildMovers(int count)
+{
+  int i;
+  bgColor = COLOR_BLACK;
+  for (i = 0; i < 4 * count && sceneLayerCount < SCENE_LAYERS - 5; i++)
+    addLayer(&moverShape, 10 + sceneRandom(108), 10 + sceneRandom(140),
+	     randomColor(), sceneRandom(7) - 3, sceneRandom(5) - 2, 0);
+  for (i = 0; i < 5; i++)
+    addLayer(&stripeShape, screenWidth/2, 16 + 32*i, COLOR_GRAY, 0, 0, LAYER_STATIC);
+}
+
+const Scene scenes[] = {
+  {"frogger", buildFrogger, advanceFrogger, probeFrogger},
+  {"circledemo", buildCircleDemo, advanceBounce, probeCircleDemo},
+  {"shapemotion", buildShapeMotionDemo, advanceShapeMotionDemo, 0},
+  {"rects", buildRects, advanceBounce, 0},
+  {"circles", buildCircles, advanceBounce, 0},
+  {"rings", buildRings, advanceBounce, 0},
+  {"arrows", buildArrows, advanceBounce, 0},
+  {"masks", buildMasks, advanceBounce, 0},
+  {"movers", buildMovers, advanceBounce, 0},
+};
+
+const int sceneCount = sizeof scenes / sizeof scenes[0];
+
+int
+sceneNamed(const Scene *scene, char **names, int count)
+{
+  int i;
+  for (i = 0; i < count; i++)
+    if (!strcmp(names[i], scene->name))
+      return 1;
+  return !count;
+}
+
+static int movCount;
+static const Scene *builtScene;
+
+Layer *
+sceneBuild(const Scene *scene, int count)
+{
+  int i;
+  seed = 1;
+  sceneLayerCount = 0;
+  builtScene = scene;
+  scene->build(count);
+  layerInit(sceneLayers);
+  layerBgBuild(sceneLayers);
+  movCount = 0;
+  for (i = 0; i < sceneLayerCount; i++) {
+    if (sceneLayers[i].flags & LAYER_STATIC)
+      continue;
+    movLayers[movCount].layer = &sceneLayers[i];
+    movLayers[movCount].velocity = velocity[i];
+    movLayers[movCount].next = 0;
+    if (movCount)
+      movLayers[movCount-1].next = &movLayers[movCount];
+    movCount++;
+  }
+  return sceneLayers;
+}
+
+void
+sceneAdvance(const Scene *scene, int frame)
+{
+  scene->advance(frame);
+}
+
+/** Methods */
+
+static void
+commitLayers()
+{
+  int i;
+  for (i = 0; i < sceneLayerCount; i++)
+    if (!(sceneLayers[i].flags & LAYER_STATIC))
+      layerCommit(&sceneLayers[i]);
+}
+
+static void
+drawProbe(Layer *layers)
+{
+  Vec2 pixel;
+  commitLayers();
+  lcd_setArea(0, 0, screenWidth-1, screenHeight-1);
+  for (pixel.axes[1] = 0; pixel.axes[1] < screenHeight; pixel.axes[1]++)
+    for (pixel.axes[0] = 0; pixel.axes[0] < screenWidth; pixel.axes[0]++)
+      lcd_writeColor(layerProbe(layers, &pixel));
+  lcd_flush();
+}
+
+/* drawProbe through the scene's LAYER_STATIC_PROBE */
+static void
+drawStatic(Layer *layers)
+{
+  Vec2 pixel;
+  (void)layers;			/* builtScene->probe knows them */
+  commitLayers();
+  lcd_setArea(0, 0, screenWidth-1, screenHeight-1);
+  for (pixel.axes[1] = 0; pixel.axes[1] < screenHeight; pixel.axes[1]++)
+    for (pixel.axes[0] = 0; pixel.axes[0] < screenWidth; pixel.axes[0]++)
+      lcd_writeColor(builtScene->probe(&pixel));
+  lcd_flush();
+}
+
+/* spans, from a LayerSet of the scene's layers */
+static void
+drawSet(Layer *layers)
+{
+  static u_char cols[SCENE_LAYERS], rows[SCENE_LAYERS], shapeIds[SCENE_LAYERS];
+  static u_int colors[SCENE_LAYERS];
+  static const AbShape *shapes[LAYERSET_SHAPES];
+  LayerSet set = {0, cols, rows, shapeIds, colors, shapes, 0};
+  int i;
+  (void)layers;			/* the set is built from sceneLayers */
+  commitLayers();
+  for (i = 0; i < sceneLayerCount; i++) {
+    Layer *l = &sceneLayers[i];
+    u_char id;
+    for (id = 0; id < set.shapeCount && shapes[id] != l->abShape; id++)
+      ;
+    if (id == set.shapeCount) {
+      if (id == LAYERSET_SHAPES) {
+	fprintf(stderr, "scenes: more than %d shapes\n", LAYERSET_SHAPES);
+	exit(1);
+      }
+      shapes[set.shapeCount++] = l->abShape;
+    }
+    layerSetMove(&set, i, l->pos.axes[0], l->pos.axes[1]);
+    shapeIds[i] = id;
+    colors[i] = l->color;
+  }
+  set.count = sceneLayerCount;
+  layerSetDraw(&set);
+}
+
+/* Layer moved in the last commit */
+static int
+moved(const Layer *l)
+{
+  return l->pos.axes[0] != l->posLast.axes[0] || l->pos.axes[1] != l->posLast.axes[1];
+}
+
+static void
+drawSpans(Layer *layers)
+{
+  commitLayers();
+  layerDraw(layers);
+}
+
+static void
+drawBounds(Layer *layers)
+{
+  int i;
+  commitLayers();
+  for (i = 0; i < sceneLayerCount; i++) {
+    Region bounds;
+    if (!moved(&sceneLayers[i]))
+      continue;
+    layerGetBounds(&sceneLayers[i], &bounds);
+    layerDrawRegion(layers, &bounds);
+  }
+}
+
+static void
+drawDamage(Layer *layers)
+{
+  movLayerDraw(movCount ? movLayers : 0, layers);
+}
+
+const Method methods[] = {
+  {"probe", drawProbe, 1},
+  {"static", drawStatic, 1},
+  {"spans", drawSpans, 1},
+  {"set", drawSet, 1},
+  {"bounds", drawBounds, 0},
+  {"damage", drawDamage, 0},
+};
+
+const int methodCount = sizeof methods / sizeof methods[0];
+
+int
+sceneMethod(const Scene *scene, const Method *method)
+{
+  return method->draw != drawStatic || scene->probe;
+}
@@ -0,0 +1,63 @@
+/** \file scenes.h
+ *  \brief Scenes of layers and ways of drawing them, shared by the host
+ *  tools (shapebench, golden)
+ */
+
+#ifndef scenes_included
+#define scenes_included
+
+#include "shape.h"
+
+#define SCENE_LAYERS 64
+
+/** Layers of the scene built last, sceneLayers[0] on top */
+extern Layer sceneLayers[SCENE_LAYERS];
+extern int sceneLayerCount;
+
+/** A scene:  build adds its layers, count sizing scenes that take it;
+ *  advance sets posNext (and LAYER_TELEPORT) of its layers for frame.
+ *  Both are repeatable:  the same frames follow every build.  probe, if
+ *  the scene has one, is layerProbe for its layers from a
+ *  LAYER_STATIC_PROBE.
+ */
+typedef struct {
+  const char *name;
+  void (*build)(int count);
+  void (*advance)(int frame);
+  u_int (*probe)(const Vec2 *pixelPos);
+} Scene;
+
+extern const Scene scenes[];
+extern const int sceneCount;
+
+/** True if scene is one of the count names, or count is 0 */
+int sceneNamed(const Scene *scene, char **names, int count);
+
+/** Build scene and prepare its layers for drawing
+ *
+ *  \return The top layer
+ */
+Layer *sceneBuild(const Scene *scene, int count);
+
+/** Set posNext of the layers of scene for frame (the methods commit) */
+void sceneAdvance(const Scene *scene, int frame);
+
+/** A way of drawing a frame
+ *
+ *  Whole screen methods draw every pixel; the others only redraw what the
+ *  last commit changed.
+ */
+typedef struct {
+  const char *name;
+  void (*draw)(Layer *layers);
+  int wholeScreen;
+} Method;
+
+/** probe (the reference), static, spans, set, bounds, damage */
+extern const Method methods[];
+extern const int methodCount;
+
+/** True if method can draw scene:  static needs the scene's probe */
+int sceneMethod(const Scene *scene, const Method *method);
+
+#endif /* scenes_included */
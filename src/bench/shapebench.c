@@ -0,0 +1,145 @@
+/** \file shapebench.c
+ *  \brief Renders scenes of layers on the simulated LCD and reports what
+ *  each way of drawing them costs per frame.
+ *
+ *  usage: shapebench [-t] [-d] [-f frames] [-n count] [scene...]
+ *
+ *  Methods:
+ *   - probe:  whole screen, layerProbe per pixel (the original compositor)
+ *   - static: whole screen, the scene's LAYER_STATIC_PROBE per pixel (for
+ *             the scenes that have one)
+ *   - spans:  whole screen, layerDraw
+ *   - set:    whole screen, layerSetDraw of the layers in a LayerSet
+ *   - bounds: moving layers redrawn over the bounding box of their old and
+ *             new positions
+ *   - damage: movLayerDraw:  moving layers redrawn through a DamageList
+ *             of the pixels they uncovered or newly covered
+ *  Whole screen methods draw one frame, the others frames of motion.
+ *
+ *  Damage against bounds, bytes/f at 64 frames, DAMAGE_MAX_REGIONS 4 and
+ *  DAMAGE_LAYER_ROOM 2:  frogger 1369 / 3422 (0.40), movers 3888 / 3949
+ *  (0.98).  Movers damages far more rectangles than a DamageList holds,
+ *  so it is drawn in flushes as the list fills; merging them instead had
+ *  sent 21355 (5.4).
+ *
+ *  Output is the same on every run, so it can be diffed across changes;
+ *  -t adds wall time per frame, which isn't.  -d dumps the last frame of
+ *  each scene and method to <scene>-<method>.ppm.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "lcdhost.h"
+#include "shape.h"
+#include "scenes.h"
+
+static int showTime, dumpFrames;
+
+static double
+now()
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void
+run(const Scene *scene, const Method *method, int frames, int count)
+{
+  LcdHostStats frame, total = {0, 0, 0, 0};
+  ShapeStats shapes;
+  double start, elapsed;
+  int f;
+
+  Layer *layers;
+
+  lcd_init();			/* forget the window of the last run */
+  layers = sceneBuild(scene, count);
+  if (method->wholeScreen)
+    frames = 1;
+  else
+    layerDraw(layers);		/* first frame, not counted */
+
+  lcdHost_frame(0);
+  memset(&shapeStats, 0, sizeof shapeStats);
+  start = now();
+  for (f = 0; f < frames; f++) {
+    if (!method->wholeScreen)
+      sceneAdvance(scene, f);
+    method->draw(layers);
+    lcdHost_frame(&frame);
+    total.commandBytes += frame.commandBytes;
+    total.dataBytes += frame.dataBytes;
+    total.pixels += frame.pixels;
+    total.setAreas += frame.setAreas;
+  }
+  elapsed = now() - start;
+  shapes = shapeStats;
+
+  printf("%-11s %-7s %4d %3d %8.1f %8.1f %7.1f %6.1f %7.2f %8.1f",
+	 scene->name, method->name, frames, sceneLayerCount,
+	 (double)total.pixels / frames,
+	 (double)(total.commandBytes + total.dataBytes) / frames,
+	 (double)total.commandBytes / frames,
+	 (double)total.setAreas / frames,
+	 total.pixels ? (double)shapes.checks / total.pixels : 0.0,
+	 (double)shapes.rowSpans / frames);
+  if (showTime)
+    printf(" %9.1f", elapsed * 1e6 / frames);
+  printf("\n");
+
+  if (dumpFrames) {
+    char path[64];
+    sprintf(path, "%s-%s.ppm", scene->name, method->name);
+    if (lcdHost_dump(path))
+      perror(path);
+  }
+}
+
+static void
+usage()
+{
+  int i;
+  fprintf(stderr, "usage: shapebench [-t] [-d] [-f frames] [-n count] [scene...]\nscenes:");
+  for (i = 0; i < sceneCount; i++)
+    fprintf(stderr, " %s", scenes[i].name);
+  fprintf(stderr, "\n");
+  exit(2);
+}
+
+int
+main(int argc, char **argv)
+{
+  int frames = 64, count = 8, i, j, arg;
+
+  for (arg = 1; arg < argc && argv[arg][0] == '-'; arg++) {
+    if (!strcmp(argv[arg], "-t"))
+      showTime = 1;
+    else if (!strcmp(argv[arg], "-d"))
+      dumpFrames = 1;
+    else if (!strcmp(argv[arg], "-f") && arg + 1 < argc)
+      frames = atoi(argv[++arg]);
+    else if (!strcmp(argv[arg], "-n") && arg + 1 < argc)
+      count = atoi(argv[++arg]);
+    else
+      usage();
+  }
+  if (frames < 1 || count < 1)
+    usage();
+
+  printf("%-11s %-7s %4s %3s %8s %8s %7s %6s %7s %8s%s\n",
+	 "scene", "method", "frms", "lay", "pixels/f", "bytes/f", "cmd/f",
+	 "area/f", "chk/px", "spans/f", showTime ? "      us/f" : "");
+  for (i = 0; i < sceneCount; i++) {
+    if (!sceneNamed(&scenes[i], argv + arg, argc - arg))
+      continue;
+    for (j = 0; j < methodCount; j++)
+      if (sceneMethod(&scenes[i], &methods[j]))
+	run(&scenes[i], &methods[j], frames, count);
+  }
+  return 0;
+}
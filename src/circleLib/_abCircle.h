@@ -12,6 +12,7 @@
 typedef struct AbCircle_s {
   void (*getBounds)(const struct AbCircle_s *circle, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbCircle_s *circle, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*rowSpans)(const struct AbCircle_s *circle, const Vec2 *centerPos, int row, Span *spans);
   const u_char *chords;
   const u_char radius;
 } AbCircle;
@@ -24,6 +25,44 @@ void abCircleGetBounds(const AbCircle *circle, const Vec2 *circlePos, Region *bo
  */
 int abCircleCheck(const AbCircle *circle, const Vec2 *circlePos, const Vec2 *pixel);
 
+/** Required by AbShape
+ */
+int abCircleRowSpans(const AbCircle *circle, const Vec2 *circlePos, int row, Span *spans);
+
+/** abCircleCheck the compiler can inline (see LAYER_STATIC_PROBE)
+ */
+static inline int
+abCircleCheckInline(const AbCircle *circle, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int col = pixel->axes[0] - centerPos->axes[0];
+  int row = pixel->axes[1] - centerPos->axes[1];
+  col = (col >= 0) ? col : -col;
+  row = (row >= 0) ? row : -row;
+  return col <= circle->radius && circle->chords[col] >= row;
+}
+
+/** AbShape circle outline:  the pixels of the AbCircle with the same
+ *  chords that are beside a pixel outside it, two spans on most rows.
+ *
+ *  Declared like the circles makeCircles generates, from chordVec.h:
+ *    AbCircleOutline ring10 = {abCircleGetBounds, abCircleOutlineCheck,
+ *                              abCircleOutlineRowSpans, chordVec10, 10};
+ */
+typedef AbCircle AbCircleOutline;	/* same as AbCircle */
+
+/** Required by AbShape
+ */
+int abCircleOutlineCheck(const AbCircleOutline *circle, const Vec2 *circlePos, const Vec2 *pixel);
+
+/** Required by AbShape
+ */
+int abCircleOutlineRowSpans(const AbCircleOutline *circle, const Vec2 *circlePos, int row, Span *spans);
+
+/** Draws circle (filled, or an AbCircleOutline) in color directly to the
+ *  LCD, a span at a time, clipped to the screen.
+ */
+void abCircleDraw(const AbCircle *circle, const Vec2 *circlePos, u_int color);
+
 #endif
 
 
@@ -1,4 +1,5 @@
 #include "shape.h"
+#include "lcddraw.h"
 #include "_abCircle.h"
 
 // true if pixel is in circle centered at centerPos
@@ -23,3 +24,90 @@ abCircleGetBounds(const AbCircle *circle, const Vec2 *centerPos, Region *bounds)
   regionClipScreen(bounds);
 }
 
+/* half width of the circle on the row dist rows from its center:  the
+ * last column whose chord reaches that row, found by binary search as
+ * chords never increase with distance.  -1 past the radius.
+ */
+static int
+halfWidth(const AbCircle *circle, int dist)
+{
+  int lo = 0, hi = circle->radius;	/* chords[lo] >= dist always */
+  if (dist < 0)
+    dist = -dist;
+  if (dist > hi)
+    return -1;
+  while (lo < hi) {
+    int mid = (lo + hi + 1) >> 1;
+    if (circle->chords[mid] >= dist)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  return lo;
+}
+
+// span of columns whose chord reaches row
+int abCircleRowSpans(const AbCircle *circle, const Vec2 *centerPos, int row, Span *spans)
+{
+  int width = halfWidth(circle, row - centerPos->axes[1]);
+  if (width < 0)
+    return 0;
+  spans[0].start = centerPos->axes[0] - width;
+  spans[0].end = centerPos->axes[0] + width;
+  return 1;
+}
+
+// true if pixel is in the circle and beside a pixel that isn't
+int abCircleOutlineCheck(const AbCircleOutline *circle, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int dist = pixel->axes[1] - centerPos->axes[1];
+  int col = pixel->axes[0] - centerPos->axes[0];
+  int width = halfWidth(circle, dist), inner;
+  col = (col >= 0) ? col : -col; /* col = |col| */
+  dist = (dist >= 0) ? dist : -dist;
+  inner = halfWidth(circle, dist + 1); /* rows further out are narrower */
+  return col <= width && (col == width || col > inner);
+}
+
+// the columns of row past the next row out, and at least the end pixels
+int abCircleOutlineRowSpans(const AbCircleOutline *circle, const Vec2 *centerPos, int row, Span *spans)
+{
+  int dist = row - centerPos->axes[1], width, inner, col = centerPos->axes[0];
+  dist = (dist >= 0) ? dist : -dist;
+  width = halfWidth(circle, dist);
+  if (width < 0)
+    return 0;
+  inner = halfWidth(circle, dist + 1) + 1; /* first outline column */
+  if (inner > width)
+    inner = width;
+  if (inner == 0) {		/* one span through the center */
+    spans[0].start = col - width;
+    spans[0].end = col + width;
+    return 1;
+  }
+  spans[0].start = col - width;
+  spans[0].end = col - inner;
+  spans[1].start = col + inner;
+  spans[1].end = col + width;
+  return 2;
+}
+
+void abCircleDraw(const AbCircle *circle, const Vec2 *centerPos, u_int color)
+{
+  Region bounds;
+  Span spans[SHAPE_MAX_SPANS];
+  int row, i;
+  abShapeGetBounds((const AbShape *)circle, centerPos, &bounds); /* clipped */
+  for (row = bounds.topLeft.axes[1]; row <= bounds.botRight.axes[1]; row++) {
+    int n = abShapeRowSpans((const AbShape *)circle, centerPos, row, spans);
+    for (i = 0; i < n; i++) {
+      int start = spans[i].start, end = spans[i].end;
+      if (start < bounds.topLeft.axes[0])
+	start = bounds.topLeft.axes[0];
+      if (end > bounds.botRight.axes[0])
+	end = bounds.botRight.axes[0];
+      if (start <= end)
+	fillRectangle(start, row, end - start + 1, 1, color);
+    }
+  }
+}
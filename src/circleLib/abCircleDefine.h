@@ -0,0 +1,207 @@
+/** \file abCircleDefine.h
+ *  \brief Circles defined at compile time, without makeCircles
+ *
+ *  ABCIRCLE_DEFINE(6) defines circle6 as makeCircles would, its chord
+ *  vector computed by the compiler from integer constant expressions
+ *  that give the same table as computeChordVec (makeCircles.c).
+ *  The radius must be a literal from 2 to 150.
+ */
+
+#ifndef abCircleDefine_included
+#define abCircleDefine_included
+
+#include "_abCircle.h"
+
+/** Defines const AbCircle circle<radius> and its chord vector */
+#define ABCIRCLE_DEFINE(radius)						\
+  static const u_char abCircleChords##radius[(radius) + 1] = {		\
+    CHORDS_##radius(radius)						\
+  };									\
+  const AbCircle circle##radius = {					\
+    abCircleGetBounds, abCircleCheck, abCircleRowSpans,		\
+    abCircleChords##radius, radius					\
+  }
+
+/* computeChordVec's Bresenham sweep of the first octant steps to the
+ * column whose midpoint test passes, so entries there count the columns
+ * k >= 1 with (2k-1)^2 + (2i)^2 <= (2r)^2.  Past the octant its mirror
+ * entries count the rows y >= 0 with (2i+1)^2 + (2y)^2 <= (2r)^2.
+ * Arithmetic is long:  (2r)^2 doesn't fit an MSP430 int.
+ */
+#define CHORD_COL(k, r, i) ((k) >= 1 && (k) <= (r) &&			\
+  (2L*(k) - 1) * (2L*(k) - 1) + 4L*(i)*(i) <= 4L*(r)*(r))
+#define CHORD_ROW(y, r, i) ((y) <= (r) &&				\
+  (2L*(i) + 1) * (2L*(i) + 1) + 4L*(y)*(y) <= 4L*(r)*(r))
+
+/* T summed over 0..150 */
+#define CHORD_SUM10(T, tens, r, i)					\
+  (T(tens##0, r, i) + T(tens##1, r, i) + T(tens##2, r, i) + T(tens##3, r, i) + \
+   T(tens##4, r, i) + T(tens##5, r, i) + T(tens##6, r, i) + T(tens##7, r, i) + \
+   T(tens##8, r, i) + T(tens##9, r, i))
+#define CHORD_SUM(T, r, i)						\
+  (CHORD_SUM10(T, , r, i) + CHORD_SUM10(T, 1, r, i) + CHORD_SUM10(T, 2, r, i) + \
+   CHORD_SUM10(T, 3, r, i) + CHORD_SUM10(T, 4, r, i) + CHORD_SUM10(T, 5, r, i) + \
+   CHORD_SUM10(T, 6, r, i) + CHORD_SUM10(T, 7, r, i) + CHORD_SUM10(T, 8, r, i) + \
+   CHORD_SUM10(T, 9, r, i) + CHORD_SUM10(T, 10, r, i) + CHORD_SUM10(T, 11, r, i) + \
+   CHORD_SUM10(T, 12, r, i) + CHORD_SUM10(T, 13, r, i) + CHORD_SUM10(T, 14, r, i) + \
+   T(150, r, i))
+
+/** Entry i of the chord vector of radius r */
+#define CHORD(r, i)							\
+  (CHORD_SUM(CHORD_COL, r, i) >= (i)					\
+   ? CHORD_SUM(CHORD_COL, r, i) : CHORD_SUM(CHORD_ROW, r, i))
+
+/* Entries 0..n of the chord vector of radius r */
+#define CHORDS_0(r) CHORD(r, 0)
+#define CHORDS_1(r) CHORDS_0(r), CHORD(r, 1)
+#define CHORDS_2(r) CHORDS_1(r), CHORD(r, 2)
+#define CHORDS_3(r) CHORDS_2(r), CHORD(r, 3)
+#define CHORDS_4(r) CHORDS_3(r), CHORD(r, 4)
+#define CHORDS_5(r) CHORDS_4(r), CHORD(r, 5)
+#define CHORDS_6(r) CHORDS_5(r), CHORD(r, 6)
+#define CHORDS_7(r) CHORDS_6(r), CHORD(r, 7)
+#define CHORDS_8(r) CHORDS_7(r), CHORD(r, 8)
+#define CHORDS_9(r) CHORDS_8(r), CHORD(r, 9)
+#define CHORDS_10(r) CHORDS_9(r), CHORD(r, 10)
+#define CHORDS_11(r) CHORDS_10(r), CHORD(r, 11)
+#define CHORDS_12(r) CHORDS_11(r), CHORD(r, 12)
+#define CHORDS_13(r) CHORDS_12(r), CHORD(r, 13)
+#define CHORDS_14(r) CHORDS_13(r), CHORD(r, 14)
+#define CHORDS_15(r) CHORDS_14(r), CHORD(r, 15)
+#define CHORDS_16(r) CHORDS_15(r), CHORD(r, 16)
+#define CHORDS_17(r) CHORDS_16(r), CHORD(r, 17)
+#define CHORDS_18(r) CHORDS_17(r), CHORD(r, 18)
+#define CHORDS_19(r) CHORDS_18(r), CHORD(r, 19)
+#define CHORDS_20(r) CHORDS_19(r), CHORD(r, 20)
+#define CHORDS_21(r) CHORDS_20(r), CHORD(r, 21)
+#define CHORDS_22(r) CHORDS_21(r), CHORD(r, 22)
+#define CHORDS_23(r) CHORDS_22(r), CHORD(r, 23)
+#define CHORDS_24(r) CHORDS_23(r), CHORD(r, 24)
+#define CHORDS_25(r) CHORDS_24(r), CHORD(r, 25)
+#define CHORDS_26(r) CHORDS_25(r), CHORD(r, 26)
+#define CHORDS_27(r) CHORDS_26(r), CHORD(r, 27)
+#define CHORDS_28(r) CHORDS_27(r), CHORD(r, 28)
+#define CHORDS_29(r) CHORDS_28(r), CHORD(r, 29)
+#define CHORDS_30(r) CHORDS_29(r), CHORD(r, 30)
+#define CHORDS_31(r) CHORDS_30(r), CHORD(r, 31)
+#define CHORDS_32(r) CHORDS_31(r), CHORD(r, 32)
+#define CHORDS_33(r) CHORDS_32(r), CHORD(r, 33)
+#define CHORDS_34(r) CHORDS_33(r), CHORD(r, 34)
+#define CHORDS_35(r) CHORDS_34(r), CHORD(r, 35)
+#define CHORDS_36(r) CHORDS_35(r), CHORD(r, 36)
+#define CHORDS_37(r) CHORDS_36(r), CHORD(r, 37)
+#define CHORDS_38(r) CHORDS_37(r), CHORD(r, 38)
+#define CHORDS_39(r) CHORDS_38(r), CHORD(r, 39)
+#define CHORDS_40(r) CHORDS_39(r), CHORD(r, 40)
+#define CHORDS_41(r) CHORDS_40(r), CHORD(r, 41)
+#define CHORDS_42(r) CHORDS_41(r), CHORD(r, 42)
+#define CHORDS_43(r) CHORDS_42(r), CHORD(r, 43)
+#define CHORDS_44(r) CHORDS_43(r), CHORD(r, 44)
+#define CHORDS_45(r) CHORDS_44(r), CHORD(r, 45)
+#define CHORDS_46(r) CHORDS_45(r), CHORD(r, 46)
+#define CHORDS_47(r) CHORDS_46(r), CHORD(r, 47)
+#define CHORDS_48(r) CHORDS_47(r), CHORD(r, 48)
+#define CHORDS_49(r) CHORDS_48(r), CHORD(r, 49)
+#define CHORDS_50(r) CHORDS_49(r), CHORD(r, 50)
+#define CHORDS_51(r) CHORDS_50(r), CHORD(r, 51)
+#define CHORDS_52(r) CHORDS_51(r), CHORD(r, 52)
+#define CHORDS_53(r) CHORDS_52(r), CHORD(r, 53)
+#define CHORDS_54(r) CHORDS_53(r), CHORD(r, 54)
+#define CHORDS_55(r) CHORDS_54(r), CHORD(r, 55)
+#define CHORDS_56(r) CHORDS_55(r), CHORD(r, 56)
+#define CHORDS_57(r) CHORDS_56(r), CHORD(r, 57)
+#define CHORDS_58(r) CHORDS_57(r), CHORD(r, 58)
+#define CHORDS_59(r) CHORDS_58(r), CHORD(r, 59)
+#define CHORDS_60(r) CHORDS_59(r), CHORD(r, 60)
+#define CHORDS_61(r) CHORDS_60(r), CHORD(r, 61)
+#define CHORDS_62(r) CHORDS_61(r), CHORD(r, 62)
+#define CHORDS_63(r) CHORDS_62(r), CHORD(r, 63)
+#define CHORDS_64(r) CHORDS_63(r), CHORD(r, 64)
+#define CHORDS_65(r) CHORDS_64(r), CHORD(r, 65)
+#define CHORDS_66(r) CHORDS_65(r), CHORD(r, 66)
+#define CHORDS_67(r) CHORDS_66(r), CHORD(r, 67)
+#define CHORDS_68(r) CHORDS_67(r), CHORD(r, 68)
+#define CHORDS_69(r) CHORDS_68(r), CHORD(r, 69)
+#define CHORDS_70(r) CHORDS_69(r), CHORD(r, 70)
+#define CHORDS_71(r) CHORDS_70(r), CHORD(r, 71)
+#define CHORDS_72(r) CHORDS_71(r), CHORD(r, 72)
+#define CHORDS_73(r) CHORDS_72(r), CHORD(r, 73)
+#define CHORDS_74(r) CHORDS_73(r), CHORD(r, 74)
+#define CHORDS_75(r) CHORDS_74(r), CHORD(r, 75)
+#define CHORDS_76(r) CHORDS_75(r), CHORD(r, 76)
+#define CHORDS_77(r) CHORDS_76(r), CHORD(r, 77)
+#define CHORDS_78(r) CHORDS_77(r), CHORD(r, 78)
+#define CHORDS_79(r) CHORDS_78(r), CHORD(r, 79)
+#define CHORDS_80(r) CHORDS_79(r), CHORD(r, 80)
+#define CHORDS_81(r) CHORDS_80(r), CHORD(r, 81)
+#define CHORDS_82(r) CHORDS_81(r), CHORD(r, 82)
+#define CHORDS_83(r) CHORDS_82(r), CHORD(r, 83)
+#define CHORDS_84(r) CHORDS_83(r), CHORD(r, 84)
+#define CHORDS_85(r) CHORDS_84(r), CHORD(r, 85)
+#define CHORDS_86(r) CHORDS_85(r), CHORD(r, 86)
+#define CHORDS_87(r) CHORDS_86(r), CHORD(r, 87)
+#define CHORDS_88(r) CHORDS_87(r), CHORD(r, 88)
+#define CHORDS_89(r) CHORDS_88(r), CHORD(r, 89)
+#define CHORDS_90(r) CHORDS_89(r), CHORD(r, 90)
+#define CHORDS_91(r) CHORDS_90(r), CHORD(r, 91)
+#define CHORDS_92(r) CHORDS_91(r), CHORD(r, 92)
+#define CHORDS_93(r) CHORDS_92(r), CHORD(r, 93)
+#define CHORDS_94(r) CHORDS_93(r), CHORD(r, 94)
+#define CHORDS_95(r) CHORDS_94(r), CHORD(r, 95)
+#define CHORDS_96(r) CHORDS_95(r), CHORD(r, 96)
+#define CHORDS_97(r) CHORDS_96(r), CHORD(r, 97)
+#define CHORDS_98(r) CHORDS_97(r), CHORD(r, 98)
+#define CHORDS_99(r) CHORDS_98(r), CHORD(r, 99)
+#define CHORDS_100(r) CHORDS_99(r), CHORD(r, 100)
+#define CHORDS_101(r) CHORDS_100(r), CHORD(r, 101)
+#define CHORDS_102(r) CHORDS_101(r), CHORD(r, 102)
+#define CHORDS_103(r) CHORDS_102(r), CHORD(r, 103)
+#define CHORDS_104(r) CHORDS_103(r), CHORD(r, 104)
+#define CHORDS_105(r) CHORDS_104(r), CHORD(r, 105)
+#define CHORDS_106(r) CHORDS_105(r), CHORD(r, 106)
+#define CHORDS_107(r) CHORDS_106(r), CHORD(r, 107)
+#define CHORDS_108(r) CHORDS_107(r), CHORD(r, 108)
+#define CHORDS_109(r) CHORDS_108(r), CHORD(r, 109)
+#define CHORDS_110(r) CHORDS_109(r), CHORD(r, 110)
+#define CHORDS_111(r) CHORDS_110(r), CHORD(r, 111)
+#define CHORDS_112(r) CHORDS_111(r), CHORD(r, 112)
+#define CHORDS_113(r) CHORDS_112(r), CHORD(r, 113)
+#define CHORDS_114(r) CHORDS_113(r), CHORD(r, 114)
+#define CHORDS_115(r) CHORDS_114(r), CHORD(r, 115)
+#define CHORDS_116(r) CHORDS_115(r), CHORD(r, 116)
+#define CHORDS_117(r) CHORDS_116(r), CHORD(r, 117)
+#define CHORDS_118(r) CHORDS_117(r), CHORD(r, 118)
+#define CHORDS_119(r) CHORDS_118(r), CHORD(r, 119)
+#define CHORDS_120(r) CHORDS_119(r), CHORD(r, 120)
+#define CHORDS_121(r) CHORDS_120(r), CHORD(r, 121)
+#define CHORDS_122(r) CHORDS_121(r), CHORD(r, 122)
+#define CHORDS_123(r) CHORDS_122(r), CHORD(r, 123)
+#define CHORDS_124(r) CHORDS_123(r), CHORD(r, 124)
+#define CHORDS_125(r) CHORDS_124(r), CHORD(r, 125)
+#define CHORDS_126(r) CHORDS_125(r), CHORD(r, 126)
+#define CHORDS_127(r) CHORDS_126(r), CHORD(r, 127)
+#define CHORDS_128(r) CHORDS_127(r), CHORD(r, 128)
+#define CHORDS_129(r) CHORDS_128(r), CHORD(r, 129)
+#define CHORDS_130(r) CHORDS_129(r), CHORD(r, 130)
+#define CHORDS_131(r) CHORDS_130(r), CHORD(r, 131)
+#define CHORDS_132(r) CHORDS_131(r), CHORD(r, 132)
+#define CHORDS_133(r) CHORDS_132(r), CHORD(r, 133)
+#define CHORDS_134(r) CHORDS_133(r), CHORD(r, 134)
+#define CHORDS_135(r) CHORDS_134(r), CHORD(r, 135)
+#define CHORDS_136(r) CHORDS_135(r), CHORD(r, 136)
+#define CHORDS_137(r) CHORDS_136(r), CHORD(r, 137)
+#define CHORDS_138(r) CHORDS_137(r), CHORD(r, 138)
+#define CHORDS_139(r) CHORDS_138(r), CHORD(r, 139)
+#define CHORDS_140(r) CHORDS_139(r), CHORD(r, 140)
+#define CHORDS_141(r) CHORDS_140(r), CHORD(r, 141)
+#define CHORDS_142(r) CHORDS_141(r), CHORD(r, 142)
+#define CHORDS_143(r) CHORDS_142(r), CHORD(r, 143)
+#define CHORDS_144(r) CHORDS_143(r), CHORD(r, 144)
+#define CHORDS_145(r) CHORDS_144(r), CHORD(r, 145)
+#define CHORDS_146(r) CHORDS_145(r), CHORD(r, 146)
+#define CHORDS_147(r) CHORDS_146(r), CHORD(r, 147)
+#define CHORDS_148(r) CHORDS_147(r), CHORD(r, 148)
+#define CHORDS_149(r) CHORDS_148(r), CHORD(r, 149)
+#define CHORDS_150(r) CHORDS_149(r), CHORD(r, 150)
+
+#endif // included
@@ -36,17 +36,88 @@ void computeChordVec(unsigned char chordVec[], unsigned char radius)
 }
 
 #include "stdio.h"
+#include "stdlib.h"
 #include "assert.h"
 
+#define RADIUS_MIN 2
+#define RADIUS_MAX 150
 
-// Generate circles as source files
-// (c) Eric Freudenthal, 2016
-int main()
+// Generate just the circles of radii, each radius once, their chord
+// vectors at offsets in the one pool circleChords, in circles/circleAtlas.c
+int makeAtlas(int count, char **radii)
 {
-  int radius;
-  char chordVec[151];
+  static unsigned char pool[(RADIUS_MAX + 2) * (RADIUS_MAX + 1) / 2];
+  int offsets[RADIUS_MAX + 1];
+  int radius, i, poolLen = 0;
   FILE *circleIncludeFile = fopen("abCircle_decls.h", "w");
   FILE *chordIncludeFile = fopen("chordVec.h", "w");
+  FILE *fp = fopen("circles/circleAtlas.c", "w");
+  assert(chordIncludeFile); assert(circleIncludeFile); assert(fp);
+
+  for (radius = 0; radius <= RADIUS_MAX; radius++)
+    offsets[radius] = -1;
+  for (i = 0; i < count; i++) {
+    radius = atoi(radii[i]);
+    if (radius < RADIUS_MIN || radius > RADIUS_MAX) {
+      fprintf(stderr, "makeCircles: radius %s not in %d..%d\n", radii[i], RADIUS_MIN, RADIUS_MAX);
+      return 1;
+    }
+    offsets[radius] = 0;
+  }
+  for (radius = RADIUS_MIN; radius <= RADIUS_MAX; radius++) {
+    if (offsets[radius] < 0)
+      continue;
+    computeChordVec(pool + poolLen, radius);
+    offsets[radius] = poolLen;
+    poolLen += radius + 1;
+  }
+
+  fprintf(fp, "// Automatically generated by makeCircles (atlas).  (c) Eric Freudenthal, 2016\n");
+  fprintf(fp, "#include \"abCircle.h\"\n");
+  fprintf(fp, "#include \"chordVec.h\"\n\n");
+  fprintf(fp, "const unsigned char circleChords[%d] = {", poolLen);
+  for (i = 0; i < poolLen; i++)
+    fprintf(fp, "%s%3d,", (i % 12) ? " " : "\n   ", pool[i]);
+  fprintf(fp, "\n};\n\n");
+
+  fprintf(circleIncludeFile, "// Automatically generated by makeCircles (atlas).  (c) Eric Freudenthal, 2016\n");
+  fprintf(circleIncludeFile, "#ifndef abCircle_decls_included\n#define abCircle_decls_included\n\n");
+  fprintf(chordIncludeFile, "// Automatically generated by makeCircles (atlas).  (c) Eric Freudenthal, 2016\n");
+  fprintf(chordIncludeFile, "#ifndef chordVec_included\n#define chordVec_included\n\n");
+  fprintf(chordIncludeFile, "extern const unsigned char circleChords[%d];\n\n", poolLen);
+
+  for (radius = RADIUS_MIN; radius <= RADIUS_MAX; radius++) {
+    if (offsets[radius] < 0)
+      continue;
+    fprintf(fp, "const AbCircle circle%d = {", radius);
+    fprintf(fp, "  abCircleGetBounds, abCircleCheck, abCircleRowSpans, chordVec%d, %d};\n", radius, radius);
+    fprintf(chordIncludeFile, "#define chordVec%d (circleChords + %d)\n", radius, offsets[radius]);
+    fprintf(circleIncludeFile, "extern const AbCircle circle%d;\n" , radius);
+  }
+
+  fprintf(circleIncludeFile, "\n#endif // included \n");
+  fprintf(chordIncludeFile, "\n#endif // included \n");
+  fclose(fp);
+  fclose(chordIncludeFile);
+  fclose(circleIncludeFile);
+  printf("makeCircles: chord pool of %d bytes\n", poolLen);
+  return 0;
+}
+
+// Generate circles as source files:  every radius, one file each, or
+// with radii as arguments an atlas of just those (see makeAtlas)
+// (c) Eric Freudenthal, 2016
+int main(int argc, char **argv)
+{
+  int radius;
+  char chordVec[RADIUS_MAX + 1];
+  FILE *circleIncludeFile;
+  FILE *chordIncludeFile;
+
+  if (argc > 1)
+    return makeAtlas(argc - 1, argv + 1);
+  circleIncludeFile = fopen("abCircle_decls.h", "w");
+  chordIncludeFile = fopen("chordVec.h", "w");
   assert(chordIncludeFile); assert(circleIncludeFile);
 
   fprintf(circleIncludeFile, "// Automatically generated by makeCircles.  (c) Eric Freudenthal, 2016\n");
@@ -55,7 +126,7 @@ int main()
   fprintf(chordIncludeFile, "// Automatically generated by makeCircles.  (c) Eric Freudenthal, 2016\n");
   fprintf(chordIncludeFile, "#ifndef chordVec_included\n#define chordVec_included\n\n");
 
-  for (radius = 2; radius <= 150; radius++) {
+  for (radius = RADIUS_MIN; radius <= RADIUS_MAX; radius++) {
     char filename[100];
     unsigned char chordIndex;
     
@@ -80,7 +151,7 @@ int main()
       fprintf(fp, "#include \"abCircle.h\"\n\n");
       fprintf(fp, "#include \"chordVec.h\"\n\n");
       fprintf(fp, "const AbCircle circle%d = {" , radius);
-      fprintf(fp, "  abCircleGetBounds, abCircleCheck, chordVec%d, %d", radius, radius);
+      fprintf(fp, "  abCircleGetBounds, abCircleCheck, abCircleRowSpans, chordVec%d, %d", radius, radius);
       fprintf(fp, "};\n");
       fclose(fp);
     }
@@ -93,6 +164,7 @@ int main()
   fprintf(chordIncludeFile, "\n#endif // included \n");
   fclose(chordIncludeFile);
   fclose(circleIncludeFile);
+  return 0;
 }
 
 
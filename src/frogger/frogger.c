@@ -7,89 +7,119 @@
 #include <lcddraw.h>
 #include <p2switches.h>
 #include <shape.h>
-#include <abCircle.h>
+#include <abCircleDefine.h>
 
 #define GREEN_LED BIT6
 
-typedef struct MovLayer_s {
-    Layer *layer;
-    Vec2 velocity;
-    struct MovLayer_s *next;
-} MovLayer;
-
 /*********************************************************************************
  * The following block is for initializing game shapes, layers, moving layers,
  * and layer hirearchiesIt also includes player positions and layer positions
  *********************************************************************************/
 
-/* Grass Segment Rectangle Shapes */
-AbRect grassShape1 = {abRectGetBounds, abRectCheck, {screenWidth/2, screenHeight/14}};
-AbRect grassShape2 = {abRectGetBounds, abRectCheck, {screenWidth/2, screenHeight/14}};
-AbRect grassShape3 = {abRectGetBounds, abRectCheck, {screenWidth/2, screenHeight/14}};
-AbRect grassShape4 = {abRectGetBounds, abRectCheck, {screenWidth/2, screenHeight/14}};
-
-/* Road Segment Rectangle Shapes */
-AbRect roadShape1 = {abRectGetBounds, abRectCheck, {screenWidth/2, screenHeight/14}};
-AbRect roadShape2 = {abRectGetBounds, abRectCheck, {screenWidth/2, screenHeight/14}};
-AbRect roadShape3 = {abRectGetBounds, abRectCheck, {screenWidth/2, screenHeight/14}};
-
-/* Car Arrow Shapes */
-AbRArrow carShape1 = {abRArrowGetBounds, abRArrowCheck, screenHeight/7};
-AbRArrow carShape2 = {abRArrowGetBounds, abRArrowCheck, screenHeight/7};
-AbRArrow carShape3 = {abRArrowGetBounds, abRArrowCheck, screenHeight/7};
+/* Grass and Road Segment Rectangle Shape, const so it stays in flash */
+const AbRect laneShape = {abRectGetBounds, abRectCheck, abRectRowSpans, {screenWidth/2, screenHeight/14}};
+
+/*
+ * Car Arrow Shape:  the right arrow of abRArrowRowSpans, CAR_SIZE across with its tip at the car's
+ * position, as a mask all three cars share. The compiler works out its bits, so it stays in flash.
+ */
+#define CAR_SIZE (screenHeight/7)
+#define CAR_START(d) ((d) <= CAR_SIZE/4 ? 0 : CAR_SIZE - CAR_SIZE/2) // First column of the row d above or below the tip:  stem and tip, or tip only
+#define CAR_ROW(d) ABMASK_SPAN_BYTE(CAR_START(d), CAR_SIZE - (d), 0), ABMASK_SPAN_BYTE(CAR_START(d), CAR_SIZE - (d), 1), ABMASK_SPAN_BYTE(CAR_START(d), CAR_SIZE - (d), 2)
+const u_char carMaskBits[ABMASK_BYTES(CAR_SIZE + 1, CAR_SIZE/2*2 + 1)] = { // Rows for a CAR_SIZE of 22
+	CAR_ROW(11), CAR_ROW(10), CAR_ROW(9), CAR_ROW(8), CAR_ROW(7), CAR_ROW(6), CAR_ROW(5), CAR_ROW(4), CAR_ROW(3), CAR_ROW(2), CAR_ROW(1),
+	CAR_ROW(0),
+	CAR_ROW(1), CAR_ROW(2), CAR_ROW(3), CAR_ROW(4), CAR_ROW(5), CAR_ROW(6), CAR_ROW(7), CAR_ROW(8), CAR_ROW(9), CAR_ROW(10), CAR_ROW(11)
+};
+const AbMask carMask = {abMaskGetBounds, abMaskCheck, abMaskRowSpans, {-CAR_SIZE, -(CAR_SIZE/2)}, CAR_SIZE + 1, CAR_SIZE/2*2 + 1, carMaskBits};
 /* Car Rectangle Shapes (optional) */
-//AbRect carShape1 = {abRectGetBounds, abRectCheck, {10, screenHeight/14-4}};
-//AbRect carShape2 = {abRectGetBounds, abRectCheck, {40, screenHeight/14-4}};
-//AbRect carShape3 = {abRectGetBounds, abRectCheck, {20, screenHeight/14-4}};
+//AbRect carShape1 = {abRectGetBounds, abRectCheck, abRectRowSpans, {10, screenHeight/14-4}};
+//AbRect carShape2 = {abRectGetBounds, abRectCheck, abRectRowSpans, {40, screenHeight/14-4}};
+//AbRect carShape3 = {abRectGetBounds, abRectCheck, abRectRowSpans, {20, screenHeight/14-4}};
 
 /*
- * Lane x pixel positions = [21, 41, 64, 87, 107]
- * Lane y pixel positions = [17, 39, 61, 83, 105, 127, 149]
- * Grass lane y positions = [17,61,105,149]
- * Road lane y positions = [39,83,127]
- * Formula for calculating x pixel position:
- * screenHeight/6*i // i => 1...5
- * Formula for calculating y pixel position:
- * (h*i)+(h/2)+(screenHeight%7) // h => height of lane, i => 0..<7
+ * The screen is LANES lanes, top (where the frog starts) to bottom, lane i centered on row
+ * LANE_Y(i): 17, 39, 61, ... The frog moves between lanes and the columns in lanePosX.
+ * The scenery paints even lanes grass and odd lanes road; a level says which lanes cars
+ * drive along, and how.
  */
+#define LANES 7
+#define LANE_HEIGHT (screenHeight/LANES)
+#define LANE_Y(i) (LANE_HEIGHT*(i) + LANE_HEIGHT/2 + screenHeight%LANES) // Screen row of lane i's center
 
+#define FROG_COLS 5
 #define START_X 2 // Starting x lane pos index for player
 #define START_Y 0 // Starting y lane pos index for player
 
-u_char lanePosX[5] = {21,41,64,87,107};
-u_char lanePosY[7] = {17,39,61,83,105,127,149};
+const u_char lanePosX[FROG_COLS] = {21,41,64,87,107};
 
 u_char frogPosInd_x = START_X; // Player x position index (lookup screen coordinate in lanePosX)
-u_char frogPosInd_y = START_Y; // Player y position index (lookup screen coordinate in lanePosY)
+u_char frogPosInd_y = START_Y; // Player y position index (lane, see LANE_Y)
 
-/* Grass Shape Layers */
-Layer grassLayer1 = {(AbShape*)&grassShape1, {64,  17}, {0, 0}, {0, 0}, COLOR_PURPLE, 0};
-Layer grassLayer2 = {(AbShape*)&grassShape2, {64,  61}, {0, 0}, {0, 0}, COLOR_PURPLE, &grassLayer1};
-Layer grassLayer3 = {(AbShape*)&grassShape3, {64, 105}, {0, 0}, {0, 0}, COLOR_PURPLE, &grassLayer2};
-Layer grassLayer4 = {(AbShape*)&grassShape4, {64, 149}, {0, 0}, {0, 0}, COLOR_PURPLE, &grassLayer3}; // Highest precedence grass layer
+/* Grass Shape Layers (scenery:  const, in flash, never written by shapeLib) */
+const Layer grassLayer1 = {(AbShape*)&laneShape, {64, LANE_Y(0)}, {64, LANE_Y(0)}, {64, LANE_Y(0)}, COLOR_PURPLE, 0, LAYER_STATIC};
+const Layer grassLayer2 = {(AbShape*)&laneShape, {64, LANE_Y(2)}, {64, LANE_Y(2)}, {64, LANE_Y(2)}, COLOR_PURPLE, (Layer*)&grassLayer1, LAYER_STATIC};
+const Layer grassLayer3 = {(AbShape*)&laneShape, {64, LANE_Y(4)}, {64, LANE_Y(4)}, {64, LANE_Y(4)}, COLOR_PURPLE, (Layer*)&grassLayer2, LAYER_STATIC};
+const Layer grassLayer4 = {(AbShape*)&laneShape, {64, LANE_Y(6)}, {64, LANE_Y(6)}, {64, LANE_Y(6)}, COLOR_PURPLE, (Layer*)&grassLayer3, LAYER_STATIC}; // Highest precedence grass layer
 
 /* Road Shape Layers */
-Layer roadLayer1 = {(AbShape*)&roadShape1, {64,  39}, {0, 0}, {0, 0}, COLOR_BLACK, &grassLayer4};
-Layer roadLayer2 = {(AbShape*)&roadShape2, {64,  83}, {0, 0}, {0, 0}, COLOR_BLACK, &roadLayer1};
-Layer roadLayer3 = {(AbShape*)&roadShape3, {64, 127}, {0, 0}, {0, 0}, COLOR_BLACK, &roadLayer2}; // Highest precedence road layer
+const Layer roadLayer1 = {(AbShape*)&laneShape, {64, LANE_Y(1)}, {64, LANE_Y(1)}, {64, LANE_Y(1)}, COLOR_BLACK, (Layer*)&grassLayer4, LAYER_STATIC};
+const Layer roadLayer2 = {(AbShape*)&laneShape, {64, LANE_Y(3)}, {64, LANE_Y(3)}, {64, LANE_Y(3)}, COLOR_BLACK, (Layer*)&roadLayer1, LAYER_STATIC};
+const Layer roadLayer3 = {(AbShape*)&laneShape, {64, LANE_Y(5)}, {64, LANE_Y(5)}, {64, LANE_Y(5)}, COLOR_BLACK, (Layer*)&roadLayer2, LAYER_STATIC}; // Highest precedence road layer
+
+#define LANE_GRASS 0 // Lane types
+#define LANE_ROAD 1
+
+/* A lane of a level:  its type and, for roads, the cars driving along it */
+typedef struct {
+	u_char type; // LANE_GRASS or LANE_ROAD
+	int speed; // Fixed point pixels per game step (see MOV_Q8), negative drives left
+	u_char cars; // Cars in the lane
+	u_char spacing; // Pixels between the cars' tips:  at least a car's width, at most (screenWidth + car width) / cars
+	u_int color; // Of the lane's cars
+} Lane;
+
+/* Levels:  one Lane per lane, top to bottom */
+const Lane level1[LANES] = {
+	{LANE_GRASS},
+	{LANE_ROAD, MOV_Q8(3), 1, 0, COLOR_BLUE},
+	{LANE_GRASS},
+	{LANE_ROAD, MOV_Q8(2), 1, 0, COLOR_ORANGE},
+	{LANE_GRASS},
+	{LANE_ROAD, MOV_Q8(4), 1, 0, COLOR_RED},
+	{LANE_GRASS},
+};
+
+#define ROADS_MAX 3 // Most road lanes in a level:  every other lane but the grass at each end
+#define CAR_POOL 3 // Most cars in a level, as many as level1 has (each takes 30 bytes of RAM, a Layer and a MovLayer); levelInit drops any past it
+
+/* Cars, handed out to the road lanes by levelInit, each road's cars together */
+Layer carPool[CAR_POOL];
+MovLayer carMovs[CAR_POOL];
+u_char carCount;
+
+/* A road lane of the level being played */
+typedef struct {
+	MovLayer *cars; // The first of the lane's count cars in carMovs
+	u_char count;
+	u_char lane; // Index in the level
+} Road;
 
-/* Car Layers */
-Layer carLayer1 = {(AbShape*)&carShape1, {0,  39}, {0, 0}, {0, 0}, COLOR_BLUE, &roadLayer3};
-Layer carLayer2 = {(AbShape*)&carShape2, {0,  83}, {0, 0}, {0, 0}, COLOR_ORANGE, &carLayer1};
-Layer carLayer3 = {(AbShape*)&carShape3, {0, 127}, {0, 0}, {0, 0}, COLOR_RED, &carLayer2}; // Highest precedence car layer
+Road roads[ROADS_MAX];
+u_char roadCount;
 
-Layer *carLayers[3] = {&carLayer1, &carLayer2, &carLayer3};
+LaneBits swept; // Columns the cars in the frog's lane covered or drove across since the last collision check
+
+#define CAR_LEFT(x) ((x) + carMask.offset.axes[0] + 1) // Columns a car at x hits:  those inside its bounds
+#define CAR_RIGHT(x) ((x) + carMask.offset.axes[0] + carMask.width - 2)
 
 /* Frog Shape and Layer */
-Layer frogLayer = {(AbShape*)&circle6, {64, 17}, {0, 0}, {0, 0}, COLOR_GREEN, &carLayer3}; // Will have the highest precedence of all layers
+ABCIRCLE_DEFINE(6); // circle6, its chords computed by the compiler
+Layer frogLayer = {(AbShape*)&circle6, {64, 17}, {0, 0}, {0, 0}, COLOR_GREEN, (Layer*)&roadLayer3}; // Will have the highest precedence of all layers
 MovLayer frog = {&frogLayer, {0,0}, 0};
+MovLayer *movLayers = &frog; // The cars (set by levelInit) and then the frog
 
-/* Moving Car Layers */
-MovLayer car1 = {&carLayer1, {3, 0}, &frog};
-MovLayer car2 = {&carLayer2, {2, 0}, &car1};
-MovLayer car3 = {&carLayer3, {4, 0}, &car2}; // Highest precedence car moving layer
-
-Region gameViewBoundary = {
+const Region gameViewBoundary = {
 	{0,0}, // Top Left Corner
 	{screenWidth,screenHeight} // Bottom Right Corner
 };
@@ -99,70 +129,80 @@ Region gameViewBoundary = {
  * and game state is implemented here.
  *********************************************************************************/
 
-// Draws moving layers
-void movLayerDraw(MovLayer *movLayers, Layer *layers) {
-	int row, col;
-	MovLayer *movLayer;
-
-	and_sr(~8);	// disable interrupts (GIE off)
-	for (movLayer = movLayers; movLayer; movLayer = movLayer->next) { // Increment moving layer positions
-		Layer *l = movLayer->layer;
-		l->posLast = l->pos;
-		l->pos = l->posNext;
-	}
-	or_sr(8); // enable interrupts (GIE on)
-
-	for (movLayer = movLayers; movLayer; movLayer = movLayer->next) { // Redraw standard layers
-		Region bounds;
-		layerGetBounds(movLayer->layer, &bounds);
-		lcd_setArea(bounds.topLeft.axes[0], bounds.topLeft.axes[1], 
-		bounds.botRight.axes[0], bounds.botRight.axes[1]);
-		for (row = bounds.topLeft.axes[1]; row <= bounds.botRight.axes[1]; row++) {
-			for (col = bounds.topLeft.axes[0]; col <= bounds.botRight.axes[0]; col++) {
-				Vec2 pixelPos = {col, row};
-				u_int color = bgColor;
-				Layer *probeLayer;
-				for (probeLayer = layers; probeLayer; probeLayer = probeLayer->next) { // probe all layers, in order
-					if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, &pixelPos)) {
-						color = probeLayer->color;
-						break; 
-					}
-				}
-				lcd_writeColor(color); 
-			}
+/* Starts the swept columns over from those the cars in the frog's lane cover */
+void sweepStart() {
+	laneBitsClear(&swept);
+	for (Road *road = roads; road < roads + roadCount; road++) {
+		if (road->lane != frogPosInd_y) continue; // Only the frog's lane can run it over
+		for (MovLayer *car = road->cars; car < road->cars + road->count; car++) {
+			int x = car->layer->posNext.axes[0];
+			laneBitsSet(&swept, CAR_LEFT(x), CAR_RIGHT(x));
 		}
 	}
-}	  
-
-// Advance car positions on x axis
-void carAdvance(MovLayer *carLayer, Region *fence) {
-	Vec2 newPos; Region shapeBoundary;
-
-	while (carLayer) {
-		vec2Add(&newPos, &carLayer->layer->posNext, &carLayer->velocity); // Add velocity increment to current position
-		abShapeGetBounds(carLayer->layer->abShape, &newPos, &shapeBoundary);
-		char carSize = ((AbRArrow*)carLayer->layer->abShape)->size;
-		if (&carLayer->velocity > 0 && shapeBoundary.botRight.axes[0] >= fence->botRight.axes[0]) // Car is moving to the right
-		  newPos.axes[0] = fence->topLeft.axes[0]-carSize; // Set car to leftmost position on screen
-		else if (&carLayer->velocity < 0 && shapeBoundary.topLeft.axes[0] <= fence->topLeft.axes[0]) // Car is moving to the left
-			newPos.axes[0] = fence->botRight.axes[0]-3; // Set car to rightmost position on screen
-		carLayer->layer->posNext = newPos; // Change layer position
-		carLayer = carLayer->next; // Move to next layer
+}
+
+/* Instantiates the cars of level's road lanes from the pool, and chains them over the scenery and under the frog */
+void levelInit(const Lane *level) {
+	Layer *below = (Layer*)&roadLayer3;
+	carCount = roadCount = 0;
+	for (u_char lane = 0; lane < LANES; lane++) {
+		if (level[lane].type != LANE_ROAD || roadCount == ROADS_MAX) continue;
+		Road *road = &roads[roadCount++];
+		road->lane = lane;
+		road->cars = &carMovs[carCount];
+		road->count = 0;
+		for (u_char i = 0; i < level[lane].cars && carCount < CAR_POOL; i++) {
+			Layer *l = &carPool[carCount];
+			MovLayer *car = &carMovs[carCount++];
+			int x = i * level[lane].spacing;
+			l->abShape = (AbShape*)&carMask;
+			l->pos = l->posNext = (Vec2){x, LANE_Y(lane)};
+			l->color = level[lane].color;
+			l->flags = 0;
+			l->next = below;
+			below = l;
+			car->layer = l;
+			car->velocity = (Vec2){level[lane].speed, 0};
+			car->frac[0] = car->frac[1] = 0;
+			road->count++;
+		}
 	}
+	sweepStart();
+	for (u_char i = 0; i < carCount; i++)
+		carMovs[i].next = i + 1 < carCount ? &carMovs[i + 1] : &frog;
+	movLayers = carCount ? carMovs : &frog;
+	frogLayer.next = below;
 }
 
-/* Determines if the any of the frog region's x coordinates resides within the car region. */
-char wasHit(Region *carReg, Region *frogReg) {
-	// Car x-coordinates
-	u_char car_tlx = carReg->topLeft.axes[0];
-	u_char car_brx = carReg->botRight.axes[0];
-	// Frog x-coordinates
-	u_char frog_tlx = frogReg->topLeft.axes[0];
-	u_char frog_brx = frogReg->botRight.axes[0];
-
-	if (frog_tlx < car_brx && frog_tlx > car_tlx) return 1; // Player hit from left
-	else if (frog_brx < car_brx && frog_brx > car_tlx) return 1; // Player hit from right
-	else return 0;
+// Advance the cars on x axis a road at a time (and the swept columns of the frog's lane). Returns true if any car moved on screen
+char carAdvance(const Region *fence) {
+	Vec2 newPos;
+	char moved = 0;
+	int around = fence->botRight.axes[0] - fence->topLeft.axes[0] + CAR_SIZE; // Distance a car drives to get back where it was
+
+	for (Road *road = roads; road < roads + roadCount; road++) {
+		char sweep = road->lane == frogPosInd_y;
+		for (MovLayer *car = road->cars; car < road->cars + road->count; car++) {
+			if (!movLayerStep(car, &newPos)) continue; // Add velocity to the car's fixed point position; same pixel, nothing to do
+			moved = 1;
+			int lastX = car->layer->posNext.axes[0], newX = newPos.axes[0];
+			char wrapped = 1;
+			if (car->velocity.axes[0] > 0 && CAR_RIGHT(newX) + 1 >= fence->botRight.axes[0]) // Car is moving to the right
+				newX -= around; // Car comes back on the left, as far behind the others as it was ahead
+			else if (car->velocity.axes[0] < 0 && CAR_LEFT(newX) - 1 <= fence->topLeft.axes[0]) // Car is moving to the left
+				newX += around; // Car comes back on the right
+			else
+				wrapped = 0;
+			if (wrapped) { // Wrapped cars don't cross the screen, just leave and reappear
+				car->layer->flags |= LAYER_TELEPORT; // Redraw old and new positions separately
+				if (sweep) laneBitsSet(&swept, CAR_LEFT(newX), CAR_RIGHT(newX));
+			} else if (sweep) // Every column between the two positions was driven over
+				laneBitsSet(&swept, CAR_LEFT(lastX < newX ? lastX : newX), CAR_RIGHT(lastX < newX ? newX : lastX));
+			newPos.axes[0] = newX;
+			car->layer->posNext = newPos; // Change layer position
+		}
+	}
+	return moved;
 }
 
 /* Moves frog position and redraws layer once its layer is changed. */
@@ -170,40 +210,40 @@ void moveFrog(u_char direction) {
 	switch (direction) {
 		case 1: // Move Frog Left
 			if(frogPosInd_x <= 0) return; // Cannot move further than this point
-			frogLayer.posNext = (Vec2){lanePosX[--frogPosInd_x], lanePosY[frogPosInd_y]};
+			frogLayer.posNext = (Vec2){lanePosX[--frogPosInd_x], LANE_Y(frogPosInd_y)};
 			break;
 		case 2: // Move Frog Right
-			if (frogPosInd_x >= 4) return; // Cannot move further than this point
-			frogLayer.posNext = (Vec2){lanePosX[++frogPosInd_x], lanePosY[frogPosInd_y]};
+			if (frogPosInd_x >= FROG_COLS - 1) return; // Cannot move further than this point
+			frogLayer.posNext = (Vec2){lanePosX[++frogPosInd_x], LANE_Y(frogPosInd_y)};
 			break;
 		case 3: // Move Frog Up
 			if (frogPosInd_y <= 0) return; // Cannot move further than this point
-			frogLayer.posNext = (Vec2){lanePosX[frogPosInd_x], lanePosY[--frogPosInd_y]};
+			frogLayer.posNext = (Vec2){lanePosX[frogPosInd_x], LANE_Y(--frogPosInd_y)};
 			break;
 		case 4: // Move Frog Down
-			if (frogPosInd_y >= 6) return; // Cannot move further than this point
-			frogLayer.posNext = (Vec2){lanePosX[frogPosInd_x], lanePosY[++frogPosInd_y]};
+			if (frogPosInd_y >= LANES - 1) return; // Cannot move further than this point
+			frogLayer.posNext = (Vec2){lanePosX[frogPosInd_x], LANE_Y(++frogPosInd_y)};
 			break;
 		default:
 			return;
 	}
+	frogLayer.flags |= LAYER_TELEPORT; // Frog jumps a whole lane position
+	sweepStart(); // Cars only count from where they are as the frog lands
 }
 
-/* Determines if frog is run over by car (frog bounds exist within bounds of a car) */
+/*
+ * Determines if frog is run over by car (a car covered, or drove across, a column of the frog's
+ * lane the frog covers since the last check or since it landed there, whichever is later), so
+ * however far cars go between checks none can pass through the frog. The caller then starts the
+ * swept columns again (sweepStart) from where the cars are.
+ */
 char didLose() {
-	for (u_char i = 0; i < 3; i++) {
-		Layer *carLayer = carLayers[i]; // Check frog position against this car layer
-		if (frogLayer.pos.axes[1] != carLayer->pos.axes[1]) continue; // Layers are not in the same lane y position
-		Region carBounds, frogBounds;
-		abShapeGetBounds(carLayer->abShape, &carLayer->pos, &carBounds);
-		abShapeGetBounds(frogLayer.abShape, &frogLayer.pos, &frogBounds);
-		if (wasHit(&carBounds, &frogBounds)) return 1; // Player hit by car, player lost
-	}
-	return 0;
+	int frogX = lanePosX[frogPosInd_x];
+	return laneBitsAny(&swept, frogX - circle6.radius, frogX + circle6.radius); // Empty unless the frog is on a road
 }
 
 /* Player is in the final lane */
-char didWin() { return frogPosInd_y >= 6; }
+char didWin() { return frogPosInd_y >= LANES - 1; }
 
 /*********************************************************************************
  * The following block is for running the game. All game setup and launch code
@@ -212,7 +252,8 @@ char didWin() { return frogPosInd_y >= 6; }
  *********************************************************************************/
 
 u_int bgColor = COLOR_BLACK; // Game background color
-int redrawScreen = 1; // Boolean for whether screen needs to be redrawn
+int redrawScreen = 1; // Boolean for whether main has work to do (wdt_handler.s keeps the CPU on when set)
+char stepDue; // Boolean for whether a game step is due
 u_int prevPress; // Switch mask for determining which buttons were previously pressed
 
 /* Setup and Configure Board and CPU Settings */
@@ -225,60 +266,82 @@ void configure()
 	lcd_init(); // Initialize LCD board screen rendering tools
 	p2sw_init(15); // Initialize 4 available board buttons using bit mask
 
+	levelInit(level1); // Put the level's cars on the road
 	layerInit(&frogLayer); // This statement is required to initialize the drawing of all shapes and layers
+	layerBgBuild(&frogLayer); // Resolve grass and road lanes from a per-row table
 	layerDraw(&frogLayer); // Draw all layers before beginning game
 
 	enableWDTInterrupts(); // enable periodic interrupt
 	or_sr(0x8); // GIE (enable interrupts)
 }
 
+/*
+ * Watchdog interrupts per game step (cars advance, collisions are checked and switches are
+ * read). Collision is swept, so this can grow, with car velocities scaled up to match,
+ * without cars passing through the frog between checks.
+ */
+#define GAME_STEP_TICKS 15
+
+/*
+ * One game step. Runs in main, not the watchdog interrupt, so the step's stack frames never
+ * sit on top of a redraw's. Returns true if anything moved on screen.
+ */
+char gameStep() {
+	u_int pressed = p2sw_read(); // Read switch input from board
+	if (didWin()) {  // Check if player's frog is in the last lane
+		Vec2 stop = {0,0}; // Stop cars from moving
+		for (u_char i = 0; i < carCount; i++)
+			carMovs[i].velocity = stop;
+		//p2sw_init(0); // Turn off switches
+	}
+	if (didLose()) { // Check if player's frog was hit by a car
+		Vec2 start = (Vec2){lanePosX[frogPosInd_x = START_X], LANE_Y(frogPosInd_y = START_Y)};
+		frogLayer.posNext = start; // Reset player position to starting point
+		frogLayer.flags |= LAYER_TELEPORT;
+	}
+	sweepStart(); // Cars count again from where they are, in the frog's lane as of now
+	char carsMoved = carAdvance(&gameViewBoundary); // Advance cars to their next position
+
+	u_int switches = ~pressed; // Actual pressed swtich values
+	u_int changed = prevPress ^ switches; // Which switches were changed from the previous state
+	if (switches & 4 && changed & 4) moveFrog(4); // Move frog down
+	if (switches & 2 && changed & 2) moveFrog(3); // Move frog up
+	if (switches & 1 && changed & 1) moveFrog(1); // Move frog left
+	if (switches & 8 && changed & 8) moveFrog(2); // Move frog right
+	prevPress = switches;
+
+	return carsMoved || frogLayer.flags & LAYER_TELEPORT; // Only redraw when something moved on screen
+}
+
 /** 
  * Initializes everything, enables interrupts and green LED, 
- * and handles the rendering for the screen
+ * and runs the game steps and the rendering for the screen
  */
 void main() {
 	configure(); // Setup MSP430
 
 	while (1) { 
-		while (!redrawScreen) { // Pause CPU if screen doesn't need updating
+		while (!redrawScreen) { // Pause CPU until the next game step
 			P1OUT &= ~GREEN_LED; // Turn Green led off while CPU is off
 			or_sr(0x10); // Turn CPU off
 		}
 		P1OUT |= GREEN_LED; // Turn Green led on while CPU is on
 		redrawScreen = 0;
-		movLayerDraw(&car3, &frogLayer); // Draw layers (top-most moving layer pointer, top-most standard layer pointer)
+		if (!stepDue) continue;
+		stepDue = 0;
+		if (gameStep())
+			movLayerDraw(movLayers, &frogLayer); // Draw layers (top-most moving layer pointer, top-most standard layer pointer)
 	}
 }
 
-// Watchdog timer interrupt handler. 15 interrupts/sec
+// Watchdog timer interrupt handler. 15 interrupts/sec. Only wakes main for each game step, so it stays shallow
 void wdt_c_handler() {
 	static short count = 0;
-	u_int pressed = p2sw_read(); // Read switch input from board
 	P1OUT |= GREEN_LED; // Green LED on when cpu on
-	if (++count == 15) {
-		if (didWin()) {  // Check if player's frog is in the last lane
-			Vec2 stop = {0,0}; // Stop cars from moving
-			car1.velocity = stop;
-			car2.velocity = stop;
-			car3.velocity = stop;
-			//p2sw_init(0); // Turn off switches
-		}
-		if (didLose()) { // Check if player's frog was hit by a car
-			Vec2 start = (Vec2){lanePosX[frogPosInd_x = START_X], lanePosY[frogPosInd_y = START_Y]};
-			frogLayer.posNext = start; // Reset player position to starting point
-		}
-		carAdvance(&car3, &gameViewBoundary); // Advance cars to their next position
-
-		u_int switches = ~pressed; // Actual pressed swtich values
-		u_int changed = prevPress ^ switches; // Which switches were changed from the previous state
-		if (switches & 4 && changed & 4) moveFrog(4); // Move frog down
-		if (switches & 2 && changed & 2) moveFrog(3); // Move frog up
-		if (switches & 1 && changed & 1) moveFrog(1); // Move frog left
-		if (switches & 8 && changed & 8) moveFrog(2); // Move frog right
-		prevPress = switches;
-		
-		if (pressed) redrawScreen = 1;
+	if (++count == GAME_STEP_TICKS) {
+		stepDue = 1;
+		redrawScreen = 1; // Wake main to run the step
 		count = 0;
-	} 
+	}
 	P1OUT &= ~GREEN_LED; // Green LED off when cpu off
 }
@@ -0,0 +1,53 @@
+# RAM (.data, .bss and .noinit) each object file takes, from the linker
+# map (-Wl,-Map=frogger.map), largest first:  what "make size" prints in
+# place of a table worked out from the declarations.
+#
+#   awk -f ramsize.awk frogger.map
+
+# output section:  .bss  0x00000200  0x120
+/^\.[A-Za-z_.]+/ {
+  out = $1
+  pending = ""
+}
+
+out != ".data" && out != ".bss" && out != ".noinit" { next }
+
+# input section, its address, size and file on the same line or the next:
+#  .bss.carPool   0x00000200   0x3c frogger.o
+#  COMMON         0x0000023c   0x10 ../lib/libShape.a(layer.o)
+/^ [.A-Z]/ {
+  if (NF == 1) {
+    pending = $1
+    next
+  }
+  add($3, $4)
+  next
+}
+
+pending != "" && /^ +0x/ {
+  add($2, $3)
+  pending = ""
+}
+
+function add(size, file,    n, i, c, d) {
+  pending = ""
+  if (size !~ /^0x/ || file == "") return
+  n = 0
+  size = tolower(substr(size, 3))
+  for (i = 1; i <= length(size); i++) {
+    c = substr(size, i, 1)
+    d = index("0123456789abcdef", c) - 1
+    n = n * 16 + d
+  }
+  if (n == 0) return
+  sub(/^.*\//, "", file)	# ../lib/libShape.a(layer.o) -> libShape.a(layer.o)
+  bytes[file] += n
+  total += n
+}
+
+END {
+  for (file in bytes)
+    printf "%6d %s\n", bytes[file], file | "sort -rn"
+  close("sort -rn")
+  printf "%6d total RAM in variables\n", total
+}
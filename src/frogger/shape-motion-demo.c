@@ -17,12 +17,6 @@
 #define GREEN_LED BIT6
 #define RED_LED BIT0
 
-typedef struct MovLayer_s {
-    Layer *layer;
-    Vec2 velocity;
-    struct MovLayer_s *next;
-} MovLayer;
-
 /*********************************************************************************/
 // My code for frogger
 
@@ -31,20 +25,20 @@ u_char midpointWidth = screenWidth / 2;
 u_char laneHeight = screenHeight / 7;
 
 /* Grass Segment Rectangle Shapes */
-AbRect grassShape1 = {abRectGetBounds, abRectCheck, {screenWidth, laneHeight}};
-AbRect grassShape2 = {abRectGetBounds, abRectCheck, {screenWidth, laneHeight}};
-AbRect grassShape3 = {abRectGetBounds, abRectCheck, {screenWidth, laneHeight}};
-AbRect grassShape4 = {abRectGetBounds, abRectCheck, {screenWidth, laneHeight}};
+AbRect grassShape1 = {abRectGetBounds, abRectCheck, abRectRowSpans, {screenWidth, laneHeight}};
+AbRect grassShape2 = {abRectGetBounds, abRectCheck, abRectRowSpans, {screenWidth, laneHeight}};
+AbRect grassShape3 = {abRectGetBounds, abRectCheck, abRectRowSpans, {screenWidth, laneHeight}};
+AbRect grassShape4 = {abRectGetBounds, abRectCheck, abRectRowSpans, {screenWidth, laneHeight}};
 
 /* Road Segment Rectangle Shapes */
-AbRect roadShape1 = {abRectGetBounds, abRectCheck, {screenWidth, laneHeight}};
-AbRect roadShape2 = {abRectGetBounds, abRectCheck, {screenWidth, laneHeight}};
-AbRect roadShape3 = {abRectGetBounds, abRectCheck, {screenWidth, laneHeight}};
+AbRect roadShape1 = {abRectGetBounds, abRectCheck, abRectRowSpans, {screenWidth, laneHeight}};
+AbRect roadShape2 = {abRectGetBounds, abRectCheck, abRectRowSpans, {screenWidth, laneHeight}};
+AbRect roadShape3 = {abRectGetBounds, abRectCheck, abRectRowSpans, {screenWidth, laneHeight}};
 
 /* Car Arrow Shapes */
-AbArrow carShape1 = {abRArrowGetBounds, abRArrowCheck, laneHeight};
-AbArrow carShape2 = {abRArrowGetBounds, abRArrowCheck, laneHeight};
-AbArrow carShape3 = {abRArrowGetBounds, abRArrowCheck, laneHeight};
+AbArrow carShape1 = {abRArrowGetBounds, abRArrowCheck, abRArrowRowSpans, laneHeight};
+AbArrow carShape2 = {abRArrowGetBounds, abRArrowCheck, abRArrowRowSpans, laneHeight};
+AbArrow carShape3 = {abRArrowGetBounds, abRArrowCheck, abRArrowRowSpans, laneHeight};
 
 /*
  * Horizontal lane y positions = [17, 39, 61, 83, 105, 127, 149]
@@ -87,7 +81,7 @@ Region gameViewBoundary = {
 /*********************************************************************************/
 
 AbRectOutline fieldOutline = {	/* playing field */
-	abRectOutlineGetBounds, abRectOutlineCheck,   
+	abRectOutlineGetBounds, abRectOutlineCheck, abRectOutlineRowSpans,
 	{screenWidth/2 - 10, screenHeight/2 - 10}
 };
 
@@ -118,43 +112,6 @@ void configure() {
 	or_sr(0x8);	              /**< GIE (enable interrupts) */
 }
 
-// Draws moving layers
-void movLayerDraw(MovLayer *movLayers, Layer *layers) {
-	int row, col;
-	MovLayer *movLayer;
-
-	and_sr(~8);	/**< disable interrupts (GIE off) */
-	for (movLayer = movLayers; movLayer; movLayer = movLayer->next) {
-		Layer *l = movLayer->layer;
-		l->posLast = l->pos;
-		l->pos = l->posNext;
-	}
-	or_sr(8);	/**< enable interrupts (GIE on) */
-
-
-	for (movLayer = movLayers; movLayer; movLayer = movLayer->next) {
-		Region bounds;
-		layerGetBounds(movLayer->layer, &bounds);
-		lcd_setArea(bounds.topLeft.axes[0], bounds.topLeft.axes[1], 
-		bounds.botRight.axes[0], bounds.botRight.axes[1]);
-		for (row = bounds.topLeft.axes[1]; row <= bounds.botRight.axes[1]; row++) {
-			for (col = bounds.topLeft.axes[0]; col <= bounds.botRight.axes[0]; col++) {
-				Vec2 pixelPos = {col, row};
-				u_int color = bgColor;
-				Layer *probeLayer;
-				for (probeLayer = layers; probeLayer; probeLayer = probeLayer->next) { /* probe all layers, in order */
-					if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, &pixelPos)) {
-						color = probeLayer->color;
-						break; 
-					}
-				}
-				lcd_writeColor(color); 
-			}
-		}
-	}
-}	  
-
-
 /** Advances a moving shape layer within a fence
  *  
  *  \param ml The moving shape to be advanced
@@ -16,33 +16,27 @@
 
 #define GREEN_LED BIT6
 
-typedef struct MovLayer_s {
-    Layer *layer;
-    Vec2 velocity;
-    struct MovLayer_s *next;
-} MovLayer;
-
 /*********************************************************************************/
 // My code for frogger
 
 /* Grass Segment Rectangle Shapes */
-AbRect grassShape1 = {abRectGetBounds, abRectCheck, {screenWidth/2, screenHeight/14}};
-AbRect grassShape2 = {abRectGetBounds, abRectCheck, {screenWidth/2, screenHeight/14}};
-AbRect grassShape3 = {abRectGetBounds, abRectCheck, {screenWidth/2, screenHeight/14}};
-AbRect grassShape4 = {abRectGetBounds, abRectCheck, {screenWidth/2, screenHeight/14}};
+AbRect grassShape1 = {abRectGetBounds, abRectCheck, abRectRowSpans, {screenWidth/2, screenHeight/14}};
+AbRect grassShape2 = {abRectGetBounds, abRectCheck, abRectRowSpans, {screenWidth/2, screenHeight/14}};
+AbRect grassShape3 = {abRectGetBounds, abRectCheck, abRectRowSpans, {screenWidth/2, screenHeight/14}};
+AbRect grassShape4 = {abRectGetBounds, abRectCheck, abRectRowSpans, {screenWidth/2, screenHeight/14}};
 
 /* Road Segment Rectangle Shapes */
-AbRect roadShape1 = {abRectGetBounds, abRectCheck, {screenWidth/2, screenHeight/14}};
-AbRect roadShape2 = {abRectGetBounds, abRectCheck, {screenWidth/2, screenHeight/14}};
-AbRect roadShape3 = {abRectGetBounds, abRectCheck, {screenWidth/2, screenHeight/14}};
+AbRect roadShape1 = {abRectGetBounds, abRectCheck, abRectRowSpans, {screenWidth/2, screenHeight/14}};
+AbRect roadShape2 = {abRectGetBounds, abRectCheck, abRectRowSpans, {screenWidth/2, screenHeight/14}};
+AbRect roadShape3 = {abRectGetBounds, abRectCheck, abRectRowSpans, {screenWidth/2, screenHeight/14}};
 
 /* Car Arrow Shapes */
-AbRArrow carShape1 = {abRArrowGetBounds, abRArrowCheck, screenHeight/7};
-AbRArrow carShape2 = {abRArrowGetBounds, abRArrowCheck, screenHeight/7};
-AbRArrow carShape3 = {abRArrowGetBounds, abRArrowCheck, screenHeight/7};
-//AbRect carShape1 = {abRectGetBounds, abRectCheck, {10, screenHeight/14-4}};
-//AbRect carShape2 = {abRectGetBounds, abRectCheck, {40, screenHeight/14-4}};
-//AbRect carShape3 = {abRectGetBounds, abRectCheck, {20, screenHeight/14-4}};
+AbRArrow carShape1 = {abRArrowGetBounds, abRArrowCheck, abRArrowRowSpans, screenHeight/7};
+AbRArrow carShape2 = {abRArrowGetBounds, abRArrowCheck, abRArrowRowSpans, screenHeight/7};
+AbRArrow carShape3 = {abRArrowGetBounds, abRArrowCheck, abRArrowRowSpans, screenHeight/7};
+//AbRect carShape1 = {abRectGetBounds, abRectCheck, abRectRowSpans, {10, screenHeight/14-4}};
+//AbRect carShape2 = {abRectGetBounds, abRectCheck, abRectRowSpans, {40, screenHeight/14-4}};
+//AbRect carShape3 = {abRectGetBounds, abRectCheck, abRectRowSpans, {20, screenHeight/14-4}};
 
 /*
  * Lane x pixel positions = [21, 41, 64, 87, 107]
@@ -114,41 +108,6 @@ void configure() {
 	or_sr(0x8); // GIE (enable interrupts)
 }
 
-// Draws moving layers
-void movLayerDraw(MovLayer *movLayers, Layer *layers) {
-	int row, col;
-	MovLayer *movLayer;
-
-	and_sr(~8);	// disable interrupts (GIE off)
-	for (movLayer = movLayers; movLayer; movLayer = movLayer->next) { // Increment moving layer positions
-		Layer *l = movLayer->layer;
-		l->posLast = l->pos;
-		l->pos = l->posNext;
-	}
-	or_sr(8); // enable interrupts (GIE on)
-
-	for (movLayer = movLayers; movLayer; movLayer = movLayer->next) { // Redraw standard layers
-		Region bounds;
-		layerGetBounds(movLayer->layer, &bounds);
-		lcd_setArea(bounds.topLeft.axes[0], bounds.topLeft.axes[1], 
-		bounds.botRight.axes[0], bounds.botRight.axes[1]);
-		for (row = bounds.topLeft.axes[1]; row <= bounds.botRight.axes[1]; row++) {
-			for (col = bounds.topLeft.axes[0]; col <= bounds.botRight.axes[0]; col++) {
-				Vec2 pixelPos = {col, row};
-				u_int color = bgColor;
-				Layer *probeLayer;
-				for (probeLayer = layers; probeLayer; probeLayer = probeLayer->next) { // probe all layers, in order
-					if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, &pixelPos)) {
-						color = probeLayer->color;
-						break; 
-					}
-				}
-				lcd_writeColor(color); 
-			}
-		}
-	}
-}	  
-
 // Advance car positions on x axis
 void carAdvance(MovLayer *carLayer, Region *fence) {
 	Vec2 newPos; Region shapeBoundary;
@@ -0,0 +1,170 @@
+# Deepest stack frogger can reach, from the -fstack-usage files (*.su) and
+# the disassembly (msp430-elf-objdump -d) of the linked program.  The
+# Makefile's size target runs it as
+#
+#   msp430-elf-objdump -d frogger.elf |
+#     awk -v ram=<.data + .bss> -f stackdepth.awk <*.su files> -
+#
+# A function's depth is its frame (from its .su line) plus the deepest of
+# its calls, 2 bytes for each return address.  Calls through a pointer
+# (abShapeGetBounds, abShapeCheck, abShapeRowSpans) are taken as the
+# deepest of the AbShape methods linked in.  Interrupts don't nest
+# (handlers run with GIE clear), so the worst case is main's deepest path
+# with the deepest handler on top of it.
+#
+# Exits 1 if that and ram don't fit the g2553's 512 bytes.
+
+BEGIN {
+  if (ramSize == "") ramSize = 512
+  if (root == "") root = "main"
+  # Handlers and their entry cost (the PC and SR the interrupt pushes)
+  if (isrs == "") isrs = "WDT Port_2"
+  # Functions written in assembly:  WDT (wdt_handler.s) pushes R4-R15
+  asmFrames = asmFrames " WDT=24"
+  n = split(asmFrames, a, " ")
+  for (i = 1; i <= n; i++) {
+    split(a[i], kv, "=")
+    frame[kv[1]] = kv[2]
+  }
+  method = "(AbShape method)"
+  frame[method] = 0
+}
+
+# name of the function at hex address h, "" if none starts there
+function fnAt(h) {
+  h = tolower(h)
+  sub(/^0x/, "", h)
+  sub(/^0+/, "", h)
+  return (h in addrName) ? addrName[h] : ""
+}
+
+function addCall(from, to, cost) {
+  if (from == "" || to == "" || to == from) return
+  ncall[from]++
+  callee[from, ncall[from]] = to
+  callCost[from, ncall[from]] = cost
+}
+
+# deepest stack a call to f reaches, in bytes; via[f] is the callee taken
+function depth(f,    i, d, best, bestCallee) {
+  if (f in memo) return memo[f]
+  if (f in active) {		# recursion:  its depth has no bound
+    recursive[f] = 1
+    return 0
+  }
+  active[f] = 1
+  best = 0
+  bestCallee = ""
+  for (i = 1; i <= ncall[f]; i++) {
+    d = depth(callee[f, i]) + callCost[f, i]
+    if (d > best) {
+      best = d
+      bestCallee = callee[f, i]
+    }
+  }
+  delete active[f]
+  if (!(f in frame)) missing[f] = 1
+  via[f] = bestCallee
+  return memo[f] = frame[f] + best
+}
+
+function path(f,    s, seen) {
+  s = f " " frame[f]
+  while (via[f] != "" && !(f in seen)) {
+    seen[f] = 1
+    f = via[f]
+    s = s " > " f " " frame[f]
+  }
+  return s
+}
+
+# file.c:line:col:name<TAB>bytes<TAB>qualifiers
+FILENAME ~ /\.su$/ {
+  split($0, f, "\t")
+  n = split(f[1], p, ":")
+  if (!(p[n] in frame) || f[2] + 0 > frame[p[n]])
+    frame[p[n]] = f[2] + 0
+  next
+}
+
+# 0000c000 <main>:
+/^[0-9a-fA-F]+ <[^>]*>:$/ {
+  fn = $2
+  gsub(/[<>:]/, "", fn)
+  sub(/\.[0-9]+$/, "", fn)	# clones are named f.isra.0, f.isra in .su
+  h = tolower($1)
+  sub(/^0+/, "", h)
+  addrName[h] = fn
+  lines[++nlines] = "F\t" fn
+  next
+}
+
+# addr:<TAB>bytes<TAB>mnemonic operands
+/^ *[0-9a-fA-F]+:\t/ {
+  n = split($0, f, "\t")
+  ins = f[3]
+  for (i = 4; i <= n; i++)
+    ins = ins " " f[i]
+  if (match(ins, /^(call|br)[ \t]/)) {
+    op = substr(ins, 1, RLENGTH - 1)
+    operand = substr(ins, RLENGTH + 1)
+    sub(/^[ \t]+/, "", operand)
+    gsub(/\t/, " ", operand)
+    gsub(/\t/, " ")
+    lines[++nlines] = op "\t" operand "\t" $0
+  }
+}
+
+END {
+  # calls are resolved once every function's address is known
+  for (i = 1; i <= nlines; i++) {
+    split(lines[i], f, "\t")
+    if (f[1] == "F") {
+      fn = f[2]
+      continue
+    }
+    operand = f[2]
+    cost = f[1] == "call" ? 2 : 0	# br #fn is a tail call
+    to = ""
+    if (match(f[3], /<[A-Za-z_][A-Za-z0-9_.]*>/)) {
+      to = substr(f[3], RSTART + 1, RLENGTH - 2)
+      sub(/\.[0-9]+$/, "", to)
+    } else if (operand ~ /^#/) {
+      if (match(f[3], /0x[0-9a-fA-F]+[^0-9a-fA-FxX]*$/)) {
+	h = substr(f[3], RSTART)
+	sub(/[^0-9a-fA-FxX].*$/, "", h)
+	to = fnAt(h)
+      } else if (match(operand, /^#-?[0-9]+/)) {
+	d = substr(operand, 2, RLENGTH - 1) + 0
+	to = fnAt(sprintf("%x", d < 0 ? d + 65536 : d))
+      }
+    } else if (f[1] == "call")
+      to = method		# through a pointer
+    addCall(fn, to, cost)
+  }
+  for (name in frame)
+    if (name ~ /^ab[A-Za-z0-9]*(GetBounds|Check|RowSpans)$/)
+      addCall(method, name, 0)
+
+  mainDepth = depth(root)
+  isrDepth = 0
+  n = split(isrs, a, " ")
+  for (i = 1; i <= n; i++) {
+    if (!(a[i] in frame) && !ncall[a[i]]) continue
+    d = depth(a[i]) + 4
+    printf "stack: %s %d bytes (with 4 of interrupt entry):  %s\n", a[i], d, path(a[i])
+    if (d > isrDepth) isrDepth = d
+  }
+  printf "stack: %s %d bytes:  %s\n", root, mainDepth, path(root)
+  for (name in missing)
+    if (name != method)
+      unknown = unknown " " name
+  if (unknown != "")
+    printf "stack: no frame size for%s (counted as 0)\n", unknown
+  for (name in recursive)
+    printf "stack: %s is recursive, its depth is unbounded\n", name
+  total = mainDepth + isrDepth
+  headroom = ramSize - ram - total
+  printf "stack: %d deepest + %d RAM = %d of %d bytes, %d to spare\n", total, ram, total + ram, ramSize, headroom
+  exit headroom < 0
+}
@@ -0,0 +1,13 @@
+#include "lcdutils.h"
+#include "font-5x7.h"
+
+/* font_5x7 transposed by the compiler:  a byte per row, bit 4 leftmost */
+#define GLYPH(c0, c1, c2, c3, c4) {				\
+    FONT_5X7_ROW(0, c0, c1, c2, c3, c4), FONT_5X7_ROW(1, c0, c1, c2, c3, c4), \
+    FONT_5X7_ROW(2, c0, c1, c2, c3, c4), FONT_5X7_ROW(3, c0, c1, c2, c3, c4), \
+    FONT_5X7_ROW(4, c0, c1, c2, c3, c4), FONT_5X7_ROW(5, c0, c1, c2, c3, c4), \
+    FONT_5X7_ROW(6, c0, c1, c2, c3, c4) },
+
+const unsigned char font_5x7_rows[96][7] = {
+  FONT_5X7(GLYPH)
+};
@@ -0,0 +1,114 @@
+/** \file font-5x7.h
+ *  \brief The 5x7 font as an X-macro, so its tables are laid out by the
+ *  compiler:  FONT_5X7(GLYPH) expands GLYPH(c0, c1, c2, c3, c4) for the
+ *  characters 0x20..0x7f, each column's bit 0 its top row.
+ */
+
+#ifndef font_5x7_included
+#define font_5x7_included
+
+/** Bits of row of the glyph with columns c0..c4, bit 4 the left column */
+#define FONT_5X7_ROW(row, c0, c1, c2, c3, c4)				\
+  ((((c0) >> (row)) & 1) << 4 | (((c1) >> (row)) & 1) << 3 |		\
+   (((c2) >> (row)) & 1) << 2 | (((c3) >> (row)) & 1) << 1 |		\
+   (((c4) >> (row)) & 1))
+
+#define FONT_5X7(GLYPH) \
+  GLYPH(0x00, 0x00, 0x00, 0x00, 0x00) /* 20 */ \
+  GLYPH(0x00, 0x00, 0x5f, 0x00, 0x00) /* 21 ! */ \
+  GLYPH(0x00, 0x07, 0x00, 0x07, 0x00) /* 22 " */ \
+  GLYPH(0x14, 0x7f, 0x14, 0x7f, 0x14) /* 23 # */ \
+  GLYPH(0x24, 0x2a, 0x7f, 0x2a, 0x12) /* 24 $ */ \
+  GLYPH(0x23, 0x13, 0x08, 0x64, 0x62) /* 25 % */ \
+  GLYPH(0x36, 0x49, 0x55, 0x22, 0x50) /* 26 & */ \
+  GLYPH(0x00, 0x05, 0x03, 0x00, 0x00) /* 27 ' */ \
+  GLYPH(0x00, 0x1c, 0x22, 0x41, 0x00) /* 28 ( */ \
+  GLYPH(0x00, 0x41, 0x22, 0x1c, 0x00) /* 29 ) */ \
+  GLYPH(0x14, 0x08, 0x3e, 0x08, 0x14) /* 2a * */ \
+  GLYPH(0x08, 0x08, 0x3e, 0x08, 0x08) /* 2b + */ \
+  GLYPH(0x00, 0x50, 0x30, 0x00, 0x00) /* 2c , */ \
+  GLYPH(0x08, 0x08, 0x08, 0x08, 0x08) /* 2d - */ \
+  GLYPH(0x00, 0x60, 0x60, 0x00, 0x00) /* 2e . */ \
+  GLYPH(0x20, 0x10, 0x08, 0x04, 0x02) /* 2f / */ \
+  GLYPH(0x3e, 0x51, 0x49, 0x45, 0x3e) /* 30 0 */ \
+  GLYPH(0x00, 0x42, 0x7f, 0x40, 0x00) /* 31 1 */ \
+  GLYPH(0x42, 0x61, 0x51, 0x49, 0x46) /* 32 2 */ \
+  GLYPH(0x21, 0x41, 0x45, 0x4b, 0x31) /* 33 3 */ \
+  GLYPH(0x18, 0x14, 0x12, 0x7f, 0x10) /* 34 4 */ \
+  GLYPH(0x27, 0x45, 0x45, 0x45, 0x39) /* 35 5 */ \
+  GLYPH(0x3c, 0x4a, 0x49, 0x49, 0x30) /* 36 6 */ \
+  GLYPH(0x01, 0x71, 0x09, 0x05, 0x03) /* 37 7 */ \
+  GLYPH(0x36, 0x49, 0x49, 0x49, 0x36) /* 38 8 */ \
+  GLYPH(0x06, 0x49, 0x49, 0x29, 0x1e) /* 39 9 */ \
+  GLYPH(0x00, 0x36, 0x36, 0x00, 0x00) /* 3a : */ \
+  GLYPH(0x00, 0x56, 0x36, 0x00, 0x00) /* 3b ; */ \
+  GLYPH(0x08, 0x14, 0x22, 0x41, 0x00) /* 3c < */ \
+  GLYPH(0x14, 0x14, 0x14, 0x14, 0x14) /* 3d = */ \
+  GLYPH(0x00, 0x41, 0x22, 0x14, 0x08) /* 3e > */ \
+  GLYPH(0x02, 0x01, 0x51, 0x09, 0x06) /* 3f ? */ \
+  GLYPH(0x32, 0x49, 0x79, 0x41, 0x3e) /* 40 @ */ \
+  GLYPH(0x7e, 0x11, 0x11, 0x11, 0x7e) /* 41 A */ \
+  GLYPH(0x7f, 0x49, 0x49, 0x49, 0x36) /* 42 B */ \
+  GLYPH(0x3e, 0x41, 0x41, 0x41, 0x22) /* 43 C */ \
+  GLYPH(0x7f, 0x41, 0x41, 0x22, 0x1c) /* 44 D */ \
+  GLYPH(0x7f, 0x49, 0x49, 0x49, 0x41) /* 45 E */ \
+  GLYPH(0x7f, 0x09, 0x09, 0x09, 0x01) /* 46 F */ \
+  GLYPH(0x3e, 0x41, 0x49, 0x49, 0x7a) /* 47 G */ \
+  GLYPH(0x7f, 0x08, 0x08, 0x08, 0x7f) /* 48 H */ \
+  GLYPH(0x00, 0x41, 0x7f, 0x41, 0x00) /* 49 I */ \
+  GLYPH(0x20, 0x40, 0x41, 0x3f, 0x01) /* 4a J */ \
+  GLYPH(0x7f, 0x08, 0x14, 0x22, 0x41) /* 4b K */ \
+  GLYPH(0x7f, 0x40, 0x40, 0x40, 0x40) /* 4c L */ \
+  GLYPH(0x7f, 0x02, 0x0c, 0x02, 0x7f) /* 4d M */ \
+  GLYPH(0x7f, 0x04, 0x08, 0x10, 0x7f) /* 4e N */ \
+  GLYPH(0x3e, 0x41, 0x41, 0x41, 0x3e) /* 4f O */ \
+  GLYPH(0x7f, 0x09, 0x09, 0x09, 0x06) /* 50 P */ \
+  GLYPH(0x3e, 0x41, 0x51, 0x21, 0x5e) /* 51 Q */ \
+  GLYPH(0x7f, 0x09, 0x19, 0x29, 0x46) /* 52 R */ \
+  GLYPH(0x46, 0x49, 0x49, 0x49, 0x31) /* 53 S */ \
+  GLYPH(0x01, 0x01, 0x7f, 0x01, 0x01) /* 54 T */ \
+  GLYPH(0x3f, 0x40, 0x40, 0x40, 0x3f) /* 55 U */ \
+  GLYPH(0x1f, 0x20, 0x40, 0x20, 0x1f) /* 56 V */ \
+  GLYPH(0x3f, 0x40, 0x38, 0x40, 0x3f) /* 57 W */ \
+  GLYPH(0x63, 0x14, 0x08, 0x14, 0x63) /* 58 X */ \
+  GLYPH(0x07, 0x08, 0x70, 0x08, 0x07) /* 59 Y */ \
+  GLYPH(0x61, 0x51, 0x49, 0x45, 0x43) /* 5a Z */ \
+  GLYPH(0x00, 0x7f, 0x41, 0x41, 0x00) /* 5b [ */ \
+  GLYPH(0x02, 0x04, 0x08, 0x10, 0x20) /* 5c ¥ */ \
+  GLYPH(0x00, 0x41, 0x41, 0x7f, 0x00) /* 5d ] */ \
+  GLYPH(0x04, 0x02, 0x01, 0x02, 0x04) /* 5e ^ */ \
+  GLYPH(0x40, 0x40, 0x40, 0x40, 0x40) /* 5f _ */ \
+  GLYPH(0x00, 0x01, 0x02, 0x04, 0x00) /* 60 ` */ \
+  GLYPH(0x20, 0x54, 0x54, 0x54, 0x78) /* 61 a */ \
+  GLYPH(0x7f, 0x48, 0x44, 0x44, 0x38) /* 62 b */ \
+  GLYPH(0x38, 0x44, 0x44, 0x44, 0x20) /* 63 c */ \
+  GLYPH(0x38, 0x44, 0x44, 0x48, 0x7f) /* 64 d */ \
+  GLYPH(0x38, 0x54, 0x54, 0x54, 0x18) /* 65 e */ \
+  GLYPH(0x08, 0x7e, 0x09, 0x01, 0x02) /* 66 f */ \
+  GLYPH(0x0c, 0x52, 0x52, 0x52, 0x3e) /* 67 g */ \
+  GLYPH(0x7f, 0x08, 0x04, 0x04, 0x78) /* 68 h */ \
+  GLYPH(0x00, 0x44, 0x7d, 0x40, 0x00) /* 69 i */ \
+  GLYPH(0x20, 0x40, 0x44, 0x3d, 0x00) /* 6a j */ \
+  GLYPH(0x7f, 0x10, 0x28, 0x44, 0x00) /* 6b k */ \
+  GLYPH(0x00, 0x41, 0x7f, 0x40, 0x00) /* 6c l */ \
+  GLYPH(0x7c, 0x04, 0x18, 0x04, 0x78) /* 6d m */ \
+  GLYPH(0x7c, 0x08, 0x04, 0x04, 0x78) /* 6e n */ \
+  GLYPH(0x38, 0x44, 0x44, 0x44, 0x38) /* 6f o */ \
+  GLYPH(0x7c, 0x14, 0x14, 0x14, 0x08) /* 70 p */ \
+  GLYPH(0x08, 0x14, 0x14, 0x18, 0x7c) /* 71 q */ \
+  GLYPH(0x7c, 0x08, 0x04, 0x04, 0x08) /* 72 r */ \
+  GLYPH(0x48, 0x54, 0x54, 0x54, 0x20) /* 73 s */ \
+  GLYPH(0x04, 0x3f, 0x44, 0x40, 0x20) /* 74 t */ \
+  GLYPH(0x3c, 0x40, 0x40, 0x20, 0x7c) /* 75 u */ \
+  GLYPH(0x1c, 0x20, 0x40, 0x20, 0x1c) /* 76 v */ \
+  GLYPH(0x3c, 0x40, 0x30, 0x40, 0x3c) /* 77 w */ \
+  GLYPH(0x44, 0x28, 0x10, 0x28, 0x44) /* 78 x */ \
+  GLYPH(0x0c, 0x50, 0x50, 0x50, 0x3c) /* 79 y */ \
+  GLYPH(0x44, 0x64, 0x54, 0x4c, 0x44) /* 7a z */ \
+  GLYPH(0x00, 0x08, 0x36, 0x41, 0x00) /* 7b { */ \
+  GLYPH(0x00, 0x00, 0x7f, 0x00, 0x00) /* 7c | */ \
+  GLYPH(0x00, 0x41, 0x36, 0x08, 0x00) /* 7d } */ \
+  GLYPH(0x10, 0x08, 0x08, 0x10, 0x08) /* 7e ~ */ \
+  GLYPH(0x00, 0x06, 0x09, 0x09, 0x06) /* 7f Deg Symbol */
+
+#endif // included
@@ -15,6 +15,7 @@ void drawPixel(u_char col, u_char row, u_int colorBGR)
 {
   lcd_setArea(col, row, col, row);
   lcd_writeColor(colorBGR);
+  lcd_flush();
 }
 
 /** Fill rectangle
@@ -30,11 +31,8 @@ void fillRectangle(u_char colMin, u_char rowMin, u_char width, u_char height,
 {
   u_char colLimit = colMin + width, rowLimit = rowMin + height;
   lcd_setArea(colMin, rowMin, colLimit - 1, rowLimit - 1);
-  u_int total = width * height;
-  u_int c = 0;
-  while ((c++) < total) {
-    lcd_writeColor(colorBGR);
-  }
+  lcd_writeColorRun(colorBGR, width * height);
+  lcd_flush();
 }
 
 /** Clear screen (fill with color)
@@ -54,22 +52,28 @@ void clearScreen(u_int colorBGR)
 void drawChar5x7(u_char rcol, u_char rrow, char c, 
      u_int fgColorBGR, u_int bgColorBGR) 
 {
-  u_char col = 0;
-  u_char row = 0;
-  u_char bit = 0x01;
-  u_char oc = c - 0x20;
+  const u_char *rows = font_5x7_rows[(u_char)(c - 0x20)];
+  u_int color = bgColorBGR;	/* of the run so far */
+  u_char run = 0, row, bit;
 
   lcd_setArea(rcol, rrow, rcol + 4, rrow + 7); /* relative to requested col/row */
-  while (row < 8) {
-    while (col < 5) {
-      u_int colorBGR = (font_5x7[oc][col] & bit) ? fgColorBGR : bgColorBGR;
-      lcd_writeColor(colorBGR);
-      col++;
+  for (row = 0; row < 7; row++) {
+    for (bit = 0x10; bit; bit >>= 1) {
+      u_int colorBGR = (rows[row] & bit) ? fgColorBGR : bgColorBGR;
+      if (colorBGR != color) {	/* runs continue across rows */
+	lcd_writeColorRun(color, run);
+	color = colorBGR;
+	run = 0;
+      }
+      run++;
     }
-    col = 0;
-    bit <<= 1;
-    row++;
   }
+  if (color != bgColorBGR) {
+    lcd_writeColorRun(color, run);
+    run = 0;
+  }
+  lcd_writeColorRun(bgColorBGR, run + 5); /* the 8th row is blank */
+  lcd_flush();
 }
 
 /** Draw string at col,row
@@ -0,0 +1,120 @@
+/** \file lcdhost.c
+ *  \brief Simulated ST7735 for host builds of lcdLib (see lcdhost.h)
+ */
+
+#include <stdio.h>
+#include "lcdutils.h"
+#include "lcdhost.h"
+
+#define CASETP 0x2A
+#define PASETP 0x2B
+#define RAMWRP 0x2C
+#define COLMOD 0x3A
+
+LcdHostStats lcdHostStats;
+int lcdHost_gie = 1;
+
+static unsigned char screen[screenHeight][screenWidth][3]; /**< RGB */
+
+static unsigned char command;	/**< last command received */
+static unsigned char params[4];	/**< its parameters so far */
+static unsigned char paramCount;
+static unsigned char colStart, colEnd, rowStart, rowEnd; /**< window */
+static unsigned char col, row;	/**< write pointer */
+static unsigned char colorMode = 0x05;
+static unsigned char pixelBytes[3]; /**< bytes of a pixel (pair) so far */
+static unsigned char pixelByteCount;
+
+/** Write the pixel at the write pointer and advance it through the window */
+static void putPixel(unsigned char r, unsigned char g, unsigned char b)
+{
+  if (col < screenWidth && row < screenHeight) {
+    screen[row][col][0] = r;
+    screen[row][col][1] = g;
+    screen[row][col][2] = b;
+  }
+  lcdHostStats.pixels++;
+  if (col++ == colEnd) {
+    col = colStart;
+    if (row++ == rowEnd)
+      row = rowStart;
+  }
+}
+
+/** Pixels are BGR:  blue in the high bits (as in lcdutils.h) */
+static void putPixel16(unsigned int color)
+{
+  putPixel((color & 0x1f) * 255 / 31, ((color >> 5) & 0x3f) * 255 / 63,
+	   (color >> 11) * 255 / 31);
+}
+
+static void putPixel12(unsigned int color)
+{
+  putPixel((color & 0xf) * 17, ((color >> 4) & 0xf) * 17, (color >> 8) * 17);
+}
+
+void lcdHost_command(unsigned char c)
+{
+  lcdHostStats.commandBytes++;
+  command = c;
+  paramCount = 0;
+  pixelByteCount = 0;		/**< a partial pixel is dropped */
+  if (c == RAMWRP) {
+    col = colStart;
+    row = rowStart;
+  }
+}
+
+void lcdHost_data(unsigned char data)
+{
+  if (command != RAMWRP) {
+    lcdHostStats.commandBytes++;
+    if (paramCount < sizeof params)
+      params[paramCount++] = data;
+    if (command == CASETP && paramCount == 4) {
+      colStart = params[1];
+      colEnd = params[3];
+    } else if (command == PASETP && paramCount == 4) {
+      rowStart = params[1];
+      rowEnd = params[3];
+    } else if (command == COLMOD && paramCount == 1)
+      colorMode = data & 0x07;
+    return;
+  }
+  lcdHostStats.dataBytes++;
+  pixelBytes[pixelByteCount++] = data;
+  if (colorMode == 0x03) {	/**< 4:4:4, two pixels in three bytes */
+    if (pixelByteCount == 3) {
+      putPixel12((pixelBytes[0] << 4) | (pixelBytes[1] >> 4));
+      putPixel12(((pixelBytes[1] & 0xf) << 8) | pixelBytes[2]);
+      pixelByteCount = 0;
+    }
+  } else if (pixelByteCount == 2) { /**< 5:6:5 */
+    putPixel16((pixelBytes[0] << 8) | pixelBytes[1]);
+    pixelByteCount = 0;
+  }
+}
+
+void lcdHost_frame(LcdHostStats *stats)
+{
+  if (stats)
+    *stats = lcdHostStats;
+  lcdHostStats.commandBytes = lcdHostStats.dataBytes = 0;
+  lcdHostStats.pixels = lcdHostStats.setAreas = 0;
+}
+
+unsigned long lcdHost_pixel(int c, int r)
+{
+  const unsigned char *p = screen[r][c];
+  return ((unsigned long)p[0] << 16) | (p[1] << 8) | p[2];
+}
+
+int lcdHost_dump(const char *path)
+{
+  FILE *fp = fopen(path, "wb");
+  if (!fp)
+    return -1;
+  fprintf(fp, "P6\n%d %d\n255\n", screenWidth, screenHeight);
+  fwrite(screen, sizeof screen, 1, fp);
+  return fclose(fp) ? -1 : 0;
+}
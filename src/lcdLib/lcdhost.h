@@ -0,0 +1,50 @@
+/** \file lcdhost.h
+ *  \brief Simulated ST7735 for host builds of lcdLib
+ *
+ *  lcdutils.c built with LCD_HOST sends its bytes here instead of to the
+ *  SPI port.  The model implements the controller's window (CASET, PASET),
+ *  write pointer (RAMWR) and pixel format (COLMOD) on a framebuffer of
+ *  screenWidth x screenHeight pixels, and counts the traffic of each frame.
+ */
+
+#ifndef lcdhost_included
+#define lcdhost_included
+
+/** Traffic to the LCD */
+typedef struct {
+  unsigned long commandBytes;	/**< commands and their parameters */
+  unsigned long dataBytes;	/**< pixel data */
+  unsigned long pixels;		/**< pixels written */
+  unsigned long setAreas;	/**< lcd_setArea and lcd_appendArea calls */
+} LcdHostStats;
+
+/** Traffic since the last lcdHost_frame */
+extern LcdHostStats lcdHostStats;
+
+/** Receive a command byte (D/C low) */
+void lcdHost_command(unsigned char command);
+
+/** Receive a data byte (D/C high) */
+void lcdHost_data(unsigned char data);
+
+/** GIE of the simulated CPU, for lcdLib built with LCD_TX_IRQ:  while it
+ *  is set the simulated transmit interrupt sends queued pixels, otherwise
+ *  lcdLib sends them itself.  Set to start with.
+ */
+extern int lcdHost_gie;
+
+/** End a frame:  copy its traffic to stats (unless 0) and start counting
+ *  the next frame
+ */
+void lcdHost_frame(LcdHostStats *stats);
+
+/** Color of the pixel at col, row as 0xRRGGBB */
+unsigned long lcdHost_pixel(int col, int row);
+
+/** Write the screen to path as a binary PPM image
+ *
+ *  \return 0 on success, -1 if the file can't be written
+ */
+int lcdHost_dump(const char *path);
+
+#endif /* lcdhost_included */
@@ -9,7 +9,11 @@
  */
  
 #include "lcdutils.h"
+#ifdef LCD_HOST
+#include "lcdhost.h"
+#else
 #include "msp430.h"
+#endif
 
 u_char _orientation = 0;
 
@@ -52,6 +56,40 @@ u_char _orientation = 0;
 #define GMCTRP1							0xE0
 #define GMCTRN1							0xE1
 
+#ifdef LCD_HOST
+
+/** Host build:  bytes go to the simulated controller in lcdhost.c */
+static void setUpSPIforLCD() {}
+
+static inline void
+lcd_writeData(u_char data)
+{
+  lcdHost_data(data);
+}
+
+#define __delay_cycles(cycles)
+
+#ifdef LCD_TX_IRQ
+/** The USCI_B0 transmitter, simulated:  its buffer is always empty and the
+ *  shift register never busy.  The interrupt runs while the CPU waits for
+ *  the queue (the only time a host program could see it), if
+ *  lcdHost_gie and the interrupt are enabled.
+ */
+static u_char IE2;
+#define UCB0TXIE 0x08
+#define UCB0TXIFG 0x08
+#define IFG2 UCB0TXIFG
+#define UCBUSY 0x01
+#define UCB0STAT 0
+#define GIE 0x08
+#define __get_SR_register() (lcdHost_gie ? GIE : 0)
+#define __interrupt_vec(vector)
+#define lcd_txByte(data) lcdHost_data(data)
+#define lcd_txWait() if (lcdHost_gie && (IE2 & UCB0TXIE)) lcd_txInterrupt()
+#endif
+
+#else /* LCD_HOST */
+
 /** Set up onboard LCD's SPI and control pins */
 static void setUpSPIforLCD() {
   LCD_DC_OUT |= LCD_DC_PIN;
@@ -78,33 +116,284 @@ static void setUpSPIforLCD() {
 
 /** Screen dimensions */
 
-/** Write data to LCD */
+/** Write data to LCD
+ *
+ *  D/C is left high between commands, so data only waits for room in the
+ *  transmit buffer and the shift register never idles between bytes.
+ */
 static inline void 
 lcd_writeData(u_char data) 
 {
-  while (UCB0STAT & UCBUSY);	/**< wait for previous transfer to complete */
-  LCD_DC_HI();			/**< specify sending data */
+  while (!(IFG2 & UCB0TXIFG));	/**< wait for room in transmit buffer */
   UCB0TXBUF = data;		/**< send data */
 }
 
-typedef union {
-  u_char colorBytes[2];
-  u_int colorBGRWord;
-} ColorBGR;
+#define lcd_txByte(data) (UCB0TXBUF = (data))
+#define lcd_txWait()		/**< the interrupt runs by itself */
+
+#endif /* LCD_HOST */
+
+#if defined(LCD_COLOR12) && defined(LCD_TX_IRQ)
+#error "LCD_COLOR12 is not available with LCD_TX_IRQ"
+#endif
+
+/** The controller's window and the index in it of the next pixel, kept
+ *  to skip window commands that would change nothing.  pixels is 0 while
+ *  the window is unknown.
+ */
+static struct {
+  u_char colStart, rowStart, colEnd, rowEnd;
+  u_char width;
+  u_int pixels, pos;
+} window;
+
+#ifdef LCD_HOST
+LcdStats lcdStats;
+#define LCD_COUNT(counter, n) (lcdStats.counter += (n))
+#else
+#define LCD_COUNT(counter, n)
+#endif
+
+/** Advance the index of the next pixel past count pixels */
+static inline void lcd_advance(u_int count)
+{
+  window.pos += count;
+  if (window.pos >= window.pixels && window.pixels)
+    window.pos %= window.pixels;
+}
+
+/** Point the controller at an area (private) */
+static void lcd_openWindow(u_char colStart, u_char rowStart, u_char colEnd, u_char rowEnd);
+
+#if !defined(LCD_TX_IRQ) && !defined(LCD_COLOR12)
+
+void lcd_writeColor(u_int colorBGR)
+{
+  lcd_advance(1);
+  lcd_writeData(colorBGR >> 8);
+  lcd_writeData(colorBGR);
+}
+
+/** Write a run of count pixels of one color */
+void lcd_writeColorRun(u_int colorBGR, u_int count)
+{
+  u_char hi = colorBGR >> 8, lo = colorBGR;
+  lcd_advance(count);
+  while (count--) {
+    lcd_writeData(hi);
+    lcd_writeData(lo);
+  }
+}
+
+/** Write n pixels from buf */
+void lcd_writePixels(const u_int *buf, u_int n)
+{
+  lcd_advance(n);
+  while (n--) {
+    u_int colorBGR = *buf++;
+    lcd_writeData(colorBGR >> 8);
+    lcd_writeData(colorBGR);
+  }
+}
+
+void lcd_flush() {}
+
+#elif defined(LCD_COLOR12)
+
+/** 12 bit pixels go out in pairs of three bytes, so a pixel waits here
+ *  for the next one.  The tracked window places a pixel still waiting
+ *  when the drawing ends.
+ */
+static u_char pixelPending;	/**< pendingColor is waiting for its pair */
+static u_int pendingColor;
+static u_int firstColor;	/**< last color written at the window's start */
+
+/** Send two pixels in three bytes */
+static void lcd_writePair(u_int color1, u_int color2)
+{
+  lcd_writeData(color1 >> 4);
+  lcd_writeData((color1 << 4) | (color2 >> 8));
+  lcd_writeData(color2);
+}
+
+void lcd_writeColorRun(u_int colorBGR, u_int count)
+{
+  u_char b0 = colorBGR >> 4, b1 = (colorBGR << 4) | (colorBGR >> 8), b2 = colorBGR;
+  if (!count)
+    return;
+  if (!window.pos || window.pos + count > window.pixels) /**< covers the window start */
+    firstColor = colorBGR;
+  lcd_advance(count);
+  if (pixelPending) {
+    lcd_writePair(pendingColor, colorBGR);
+    pixelPending = 0;
+    count--;
+  }
+  for (; count >= 2; count -= 2) {
+    lcd_writeData(b0);
+    lcd_writeData(b1);
+    lcd_writeData(b2);
+  }
+  if (count) {
+    pixelPending = 1;
+    pendingColor = colorBGR;
+  }
+}
+
+void lcd_writeColor(u_int colorBGR)
+{
+  lcd_writeColorRun(colorBGR, 1);
+}
+
+void lcd_writePixels(const u_int *buf, u_int n)
+{
+  while (n--)
+    lcd_writeColorRun(*buf++, 1);
+}
+
+/** Send a pixel waiting for its pair.  If it is the last of the window the
+ *  pair wraps to the window's first pixel, which is rewritten unchanged;
+ *  otherwise it is sent twice to a one pixel window at its place.
+ */
+void lcd_flush()
+{
+  u_int index;
+  u_char col, row;
+  if (!pixelPending)
+    return;
+  pixelPending = 0;
+  if (!window.pos) {
+    lcd_writePair(pendingColor, firstColor);
+    window.pos = 1;
+    return;
+  }
+  index = window.pos - 1;
+  col = window.colStart + index % window.width;
+  row = window.rowStart + index / window.width;
+  lcd_openWindow(col, row, col, row);
+  lcd_writePair(pendingColor, pendingColor);
+  window.pos = 0;
+  firstColor = pendingColor;
+}
+
+#else /* LCD_TX_IRQ */
+
+/** Queued runs of pixels, drained by the USCI_B0 transmit interrupt.
+ *  Holds about two scanlines of runs:  the CPU composes the next line
+ *  while the previous one is being sent.
+ */
+static volatile struct {
+  u_int color, count;
+} runQueue[LCD_RUN_QUEUE];
+static volatile u_char queueHead, queueTail; /**< next to send, next free */
+static volatile u_char sendLow;	/**< low byte of the pixel is next */
+
+/** Send the next queued byte (TXBUF must be empty) */
+static void lcd_sendQueued()
+{
+  if (queueHead == queueTail) {	/**< drained */
+    IE2 &= ~UCB0TXIE;
+    return;
+  }
+  if (!sendLow) {
+    lcd_txByte(runQueue[queueHead].color >> 8);
+    sendLow = 1;
+  } else {
+    lcd_txByte(runQueue[queueHead].color);
+    sendLow = 0;
+    if (!--runQueue[queueHead].count) {
+      queueHead = (queueHead + 1) % LCD_RUN_QUEUE;
+      if (queueHead == queueTail)
+	IE2 &= ~UCB0TXIE;
+    }
+  }
+}
+
+void __interrupt_vec(USCIAB0TX_VECTOR) lcd_txInterrupt()
+{
+  lcd_sendQueued();
+}
+
+/** Send the next queued byte here if interrupts are off (and there's room
+ *  in the transmit buffer), otherwise let the interrupt send it
+ */
+static void lcd_sendWaiting()
+{
+  if (!(__get_SR_register() & GIE)) {
+    if (IFG2 & UCB0TXIFG)
+      lcd_sendQueued();
+  } else
+    lcd_txWait();
+}
+
+/** Wait for room in the queue */
+static void lcd_waitRoom()
+{
+  while ((queueTail + 1) % LCD_RUN_QUEUE == queueHead)
+    lcd_sendWaiting();
+}
+
+void lcd_writeColorRun(u_int colorBGR, u_int count)
+{
+  u_char tail = queueTail;
+  if (!count)
+    return;
+  lcd_advance(count);
+  lcd_waitRoom();
+  runQueue[tail].color = colorBGR;
+  runQueue[tail].count = count;
+  queueTail = (tail + 1) % LCD_RUN_QUEUE;
+  IE2 |= UCB0TXIE;		/**< interrupt sends it */
+}
 
 void lcd_writeColor(u_int colorBGR)
 {
-  ColorBGR colorU = {.colorBGRWord = colorBGR};
-  lcd_writeData(colorU.colorBytes[1]);
-  lcd_writeData(colorU.colorBytes[0]);
+  lcd_writeColorRun(colorBGR, 1);
+}
+
+void lcd_writePixels(const u_int *buf, u_int n)
+{
+  while (n--)
+    lcd_writeColorRun(*buf++, 1);
 }
 
+/** Wait until every queued pixel has been sent */
+static void lcd_drain()
+{
+  while (queueHead != queueTail)
+    lcd_sendWaiting();
+  while (UCB0STAT & UCBUSY);	/**< last byte sent */
+}
+
+/** With interrupts on the queue drains itself (on the host, only while
+ *  the CPU waits:  the frame is drained to be seen)
+ */
+void lcd_flush()
+{
+#ifndef LCD_HOST
+  if (__get_SR_register() & GIE)
+    return;
+#endif
+  lcd_drain();
+}
+
+#endif /* LCD_TX_IRQ, LCD_COLOR12 */
+
 /** Write command to LCD (private) */
 void _writeCommand(u_char command) 
 {
+#ifdef LCD_TX_IRQ
+  lcd_drain();			/**< queued pixels belong to the previous command */
+#endif
+#ifdef LCD_HOST
+  lcdHost_command(command);
+#else
   while (UCB0STAT & UCBUSY);	/**< wait for previous transfer to complete */
   LCD_DC_LO();			          /**< specify sending a command */
   UCB0TXBUF = command;		    /**< send command */
+  while (UCB0STAT & UCBUSY);	/**< command must leave before D/C changes */
+  LCD_DC_HI();			          /**< back to sending data */
+#endif
 }
 
 /** Long delay (private) */
@@ -115,32 +404,84 @@ void _delay(u_char x10ms) {
 	}
 }
 
+static void lcd_openWindow(u_char colStart, u_char rowStart, u_char colEnd, u_char rowEnd)
+{
+  if (!window.pixels || colStart != window.colStart || colEnd != window.colEnd) {
+    _writeCommand(CASETP);
+    lcd_writeData(0);
+    lcd_writeData(colStart);
+    lcd_writeData(0);
+    lcd_writeData(colEnd);
+    LCD_COUNT(commandBytes, 5);
+  } else
+    LCD_COUNT(commandBytesSaved, 5);
+  if (!window.pixels || rowStart != window.rowStart || rowEnd != window.rowEnd) {
+    _writeCommand(PASETP);
+    lcd_writeData(0);
+    lcd_writeData(rowStart);
+    lcd_writeData(0);
+    lcd_writeData(rowEnd);
+    LCD_COUNT(commandBytes, 5);
+  } else
+    LCD_COUNT(commandBytesSaved, 5);
+  _writeCommand(RAMWRP);	/**< write from the window's start */
+  LCD_COUNT(commandBytes, 1);
+  window.colStart = colStart;
+  window.rowStart = rowStart;
+  window.colEnd = colEnd;
+  window.rowEnd = rowEnd;
+  window.width = colEnd - colStart + 1;
+  window.pixels = window.width * (rowEnd - rowStart + 1);
+  window.pos = 0;
+}
+
+/** Open an area reaching down to windowRowEnd, unless the next pixel of
+ *  the window already is the area's first and the area follows it
+ */
+static void lcd_area(u_char colStart, u_char rowStart, u_char colEnd, u_char rowEnd,
+		     u_char windowRowEnd)
+{
+#ifdef LCD_HOST
+  lcdHostStats.setAreas++;
+#endif
+  if (window.pixels && colStart == window.colStart && colEnd == window.colEnd &&
+      rowStart >= window.rowStart && rowEnd <= window.rowEnd &&
+      window.pos == (u_int)(rowStart - window.rowStart) * window.width) {
+    LCD_COUNT(commandBytesSaved, 11);
+    return;
+  }
+#ifdef LCD_COLOR12
+  lcd_flush();			/**< finish the previous window */
+#endif
+  lcd_openWindow(colStart, rowStart, colEnd, windowRowEnd);
+}
+
 /** Set area to draw to */
 void lcd_setArea(u_char colStart, u_char rowStart, u_char colEnd, u_char rowEnd) 
 {
-	_writeCommand(CASETP);
-	lcd_writeData(0);
-	lcd_writeData(colStart);
-	lcd_writeData(0);
-	lcd_writeData(colEnd);
-	_writeCommand(PASETP);
-	lcd_writeData(0);
-	lcd_writeData(rowStart);
-	lcd_writeData(0);
-	lcd_writeData(rowEnd);
-	_writeCommand(RAMWRP);
+  lcd_area(colStart, rowStart, colEnd, rowEnd, rowEnd);
 }
 
+void lcd_appendArea(u_char colStart, u_char rowStart, u_char colEnd, u_char rowEnd)
+{
+  lcd_area(colStart, rowStart, colEnd, rowEnd, screenHeight - 1);
+}
 /** Initialize onboard LCD */
 void lcd_init() 
 {
   setUpSPIforLCD();
+  window.pixels = 0;		/**< window unknown */
   _writeCommand(SWRESET);  /**< software reset */
   _delay(20);
   _writeCommand(SLEEPOUT); /**< exit sleep */
   _delay(20);
+#ifdef LCD_COLOR12
+  _writeCommand(COLMOD);   /**< Set Color Format 12bit */
+  lcd_writeData(0x03);
+#else
   _writeCommand(COLMOD);   /**< Set Color Format 16bit */
   lcd_writeData(0x05);
+#endif
   _writeCommand(DISPON);   /**< display ON */
 
   _writeCommand(MADCTL);
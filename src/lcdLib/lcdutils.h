@@ -11,6 +11,7 @@ typedef unsigned char u_char;
 typedef unsigned int u_int;
 
 extern const unsigned char font_5x7[96][5];
+extern const unsigned char font_5x7_rows[96][7]; /* by row, bit 4 leftmost */
 extern const unsigned char font_8x12[95][12];
 extern const unsigned int font_11x16[95][11];
 
@@ -50,60 +51,138 @@ void lcd_init();
  */
 void lcd_setArea(u_char colStart, u_char rowStart, u_char colEnd, u_char rowEnd);
 
+/** Set area to draw to, leaving the window open below it
+ *
+ *  Like lcd_setArea, but the LCD's window reaches down to the last row,
+ *  so an area with the same columns starting right after the last pixel
+ *  written continues it without window commands.  lcd_setArea also skips
+ *  commands for such areas, and the column or row commands of a window
+ *  that only changes the other.
+ */
+void lcd_appendArea(u_char colStart, u_char rowStart, u_char colEnd, u_char rowEnd);
+
+#ifdef LCD_HOST
+/** Command bytes sent to set windows, and those skipped as redundant
+ *  (counted on the host only, see bench/)
+ */
+typedef struct {
+  unsigned long commandBytes, commandBytesSaved;
+} LcdStats;
+
+extern LcdStats lcdStats;
+#endif
+
 /** Write color to LCD
  *
  *  \param colorBGR The color in BGR
  */
 void lcd_writeColor(u_int colorBGR);
 
+/** Write count pixels of the same color to LCD
+ *
+ *  \param colorBGR The color in BGR
+ *  \param count Number of pixels
+ */
+void lcd_writeColorRun(u_int colorBGR, u_int count);
+
+/** Write a burst of pixels to LCD
+ *
+ *  \param buf The pixel colors in BGR
+ *  \param n Number of pixels in buf
+ */
+void lcd_writePixels(const u_int *buf, u_int n);
+
+/** Finish the pixels written so far
+ *
+ *  Call after the last pixel of a drawing:  a 12 bit pixel waiting for
+ *  its pair is sent, and queued pixels are sent here if interrupts are off.
+ *  Pixels written afterwards need a new lcd_setArea.
+ */
+void lcd_flush();
+
+/** Interrupt driven output (experimental, off by default)
+ *
+ *  When lcdLib is built with LCD_TX_IRQ defined, pixel writes are queued
+ *  as runs and sent by the USCI_B0 transmit interrupt, so callers compose
+ *  the next pixels while earlier ones are sent.  Writes wait for room in
+ *  the queue; with interrupts disabled they send from it themselves.
+ *  A full 128 pixel line buffer would not fit in RAM twice, so the queue
+ *  holds LCD_RUN_QUEUE runs (4 bytes each) instead.
+ *
+ *  The interrupt is taken once per byte.  The SPI clock lcd_init sets is
+ *  SMCLK/1, and configureClocks sets SMCLK to DCO/8, so a byte goes out
+ *  in 64 CPU cycles.  The interrupt's entry, queue work and return take
+ *  most of them, leaving little for composing pixels; no saving over
+ *  polling has been measured on a board.
+ */
+#ifndef LCD_RUN_QUEUE
+#define LCD_RUN_QUEUE 16
+#endif
+
+/** 12 bit color
+ *
+ *  When LCD_COLOR12 is defined (here, so that every user of this header
+ *  agrees), the LCD takes 4:4:4 pixels packed two to three bytes, a
+ *  quarter less SPI traffic than 5:6:5.  Colors are then 12 bit values and
+ *  the constants below are converted by LCD_COLOR at compile time.
+ *  Not available with LCD_TX_IRQ.
+ */
+/* #define LCD_COLOR12 */
+
+#ifdef LCD_COLOR12
+#define LCD_COLOR(bgr565) ((((bgr565) >> 4) & 0xf00) | (((bgr565) >> 3) & 0x0f0) | (((bgr565) >> 1) & 0x00f))
+#else
+#define LCD_COLOR(bgr565) (bgr565)
+#endif
+
 #define rgb2bgr(val) ((((val) << 11)&0xf800) | ((val)&0x7e0) | (((val)>>11)&0x1f))
 
 /** Colors */
-#define BLACK 0x0000
-#define WHITE 0xFFFF
+#define BLACK LCD_COLOR(0x0000)
+#define WHITE LCD_COLOR(0xFFFF)
 #define COLOR_BLACK   BLACK
 #define COLOR_WHITE   WHITE
 
-#define COLOR_BLUE              0xf800
-#define COLOR_RED 		0x001f
-#define COLOR_GREEN   		0x07e0
-#define COLOR_CYAN    		0xffe0
-#define COLOR_MAGENTA 		0xf81f
-#define COLOR_YELLOW  		0x07ff
-#define COLOR_ORANGE		0x053f
-#define COLOR_ORANGE_RED	0x023f
-#define COLOR_DARK_ORANGE	0x047f
-#define COLOR_GRAY		0xbdf7
-#define COLOR_NAVY		0x8000
-#define COLOR_ROYAL_BLUE	0xe348
-#define COLOR_SKY_BLUE		0xee70
-#define COLOR_TURQUOISE		0xd708
-#define COLOR_STEEL_BLUE	0xb408
-#define COLOR_LIGHT_BLUE	0xe6d5
-#define COLOR_AQUAMARINE	0xd7ef
-#define COLOR_DARK_GREEN	0x0320
-#define COLOR_DARK_OLIVE_GREEN	0x2b4a
-#define COLOR_SEA_GREEN		0x5445
-#define COLOR_SPRING_GREEN	0x7fe0
-#define COLOR_PALE_GREEN	0x9fd3
-#define COLOR_GREEN_YELLOW	0x2ff5
-#define COLOR_LIME_GREEN	0x3666
-#define COLOR_FOREST_GREEN	0x2444
-#define COLOR_KHAKI		0x8f3e
-#define COLOR_GOLD		0x06bf
-#define COLOR_GOLDENROD		0x253b
-#define COLOR_SIENNA		0x2a94
-#define COLOR_BEIGE		0xdfbe
-#define COLOR_TAN		0x8dba
-#define COLOR_BROWN		0x2954
-#define COLOR_CHOCOLATE		0x1b5a
-#define COLOR_FIREBRICK		0x2116
-#define COLOR_HOT_PINK		0xb35f
-#define COLOR_PINK		0xce1f
-#define COLOR_DEEP		0x90bf
-#define COLOR_VIOLET		0xec1d
-#define COLOR_DARK_VIOLE	0xd012
-#define COLOR_PURPLE		0xf114
-#define COLOR_MEDIUM_PURPLE	0xdb92
+#define COLOR_BLUE              LCD_COLOR(0xf800)
+#define COLOR_RED 		LCD_COLOR(0x001f)
+#define COLOR_GREEN   		LCD_COLOR(0x07e0)
+#define COLOR_CYAN    		LCD_COLOR(0xffe0)
+#define COLOR_MAGENTA 		LCD_COLOR(0xf81f)
+#define COLOR_YELLOW  		LCD_COLOR(0x07ff)
+#define COLOR_ORANGE		LCD_COLOR(0x053f)
+#define COLOR_ORANGE_RED	LCD_COLOR(0x023f)
+#define COLOR_DARK_ORANGE	LCD_COLOR(0x047f)
+#define COLOR_GRAY		LCD_COLOR(0xbdf7)
+#define COLOR_NAVY		LCD_COLOR(0x8000)
+#define COLOR_ROYAL_BLUE	LCD_COLOR(0xe348)
+#define COLOR_SKY_BLUE		LCD_COLOR(0xee70)
+#define COLOR_TURQUOISE		LCD_COLOR(0xd708)
+#define COLOR_STEEL_BLUE	LCD_COLOR(0xb408)
+#define COLOR_LIGHT_BLUE	LCD_COLOR(0xe6d5)
+#define COLOR_AQUAMARINE	LCD_COLOR(0xd7ef)
+#define COLOR_DARK_GREEN	LCD_COLOR(0x0320)
+#define COLOR_DARK_OLIVE_GREEN	LCD_COLOR(0x2b4a)
+#define COLOR_SEA_GREEN		LCD_COLOR(0x5445)
+#define COLOR_SPRING_GREEN	LCD_COLOR(0x7fe0)
+#define COLOR_PALE_GREEN	LCD_COLOR(0x9fd3)
+#define COLOR_GREEN_YELLOW	LCD_COLOR(0x2ff5)
+#define COLOR_LIME_GREEN	LCD_COLOR(0x3666)
+#define COLOR_FOREST_GREEN	LCD_COLOR(0x2444)
+#define COLOR_KHAKI		LCD_COLOR(0x8f3e)
+#define COLOR_GOLD		LCD_COLOR(0x06bf)
+#define COLOR_GOLDENROD		LCD_COLOR(0x253b)
+#define COLOR_SIENNA		LCD_COLOR(0x2a94)
+#define COLOR_BEIGE		LCD_COLOR(0xdfbe)
+#define COLOR_TAN		LCD_COLOR(0x8dba)
+#define COLOR_BROWN		LCD_COLOR(0x2954)
+#define COLOR_CHOCOLATE		LCD_COLOR(0x1b5a)
+#define COLOR_FIREBRICK		LCD_COLOR(0x2116)
+#define COLOR_HOT_PINK		LCD_COLOR(0xb35f)
+#define COLOR_PINK		LCD_COLOR(0xce1f)
+#define COLOR_DEEP		LCD_COLOR(0x90bf)
+#define COLOR_VIOLET		LCD_COLOR(0xec1d)
+#define COLOR_DARK_VIOLE	LCD_COLOR(0xd012)
+#define COLOR_PURPLE		LCD_COLOR(0xf114)
+#define COLOR_MEDIUM_PURPLE	LCD_COLOR(0xdb92)
 
 #endif /* lcdutils_included */
@@ -0,0 +1,267 @@
+#include "shape.h"
+
+/** Pieces of a new rectangle waiting to be placed (on the stack), at
+ *  least the 4 damageSplit may push
+ */
+#define DAMAGE_WORK 4
+
+void
+damageInit(DamageList *damage, Layer *layers)
+{
+  damage->count = 0;
+  damage->layers = layers;
+#ifdef SHAPE_STATS
+  damage->added.pixelsRaw = damage->added.pixels = 0;
+  damage->added.regions = 0;
+  damage->frame = damage->added;
+#endif
+}
+
+// draw the regions held so far and empty the list
+static void
+damageFlush(DamageList *damage)
+{
+#ifdef SHAPE_STATS
+  u_char i;
+  damage->added.regions += damage->count;
+  for (i = 0; i < damage->count; i++)
+    damage->added.pixels += regionArea(&damage->regions[i]);
+#endif
+  if (damage->count)
+    layerDrawRegions(damage->layers, damage->regions, damage->count);
+  damage->count = 0;
+}
+
+// pixels redrawn needlessly if r1 and r2 are drawn as their bounding box
+static int
+mergeWaste(const Region *r1, const Region *r2)
+{
+  Region rUnion, overlap;
+  int covered = regionArea(r1) + regionArea(r2);
+  if (regionIntersect(&overlap, r1, r2))
+    covered -= regionArea(&overlap);
+  regionUnion(&rUnion, r1, r2);
+  return regionArea(&rUnion) - covered;
+}
+
+static void
+damageRemove(DamageList *damage, u_char i)
+{
+  damage->regions[i] = damage->regions[--damage->count];
+}
+
+// push the parts of r outside overlap (which lies within r), at most 4
+static u_char
+damageSplit(Region *work, u_char pending, const Region *r, const Region *overlap)
+{
+  Region piece;
+  if (r->topLeft.axes[1] < overlap->topLeft.axes[1]) { /* above */
+    piece = *r;
+    piece.botRight.axes[1] = overlap->topLeft.axes[1] - 1;
+    work[pending++] = piece;
+  }
+  if (r->botRight.axes[1] > overlap->botRight.axes[1]) { /* below */
+    piece = *r;
+    piece.topLeft.axes[1] = overlap->botRight.axes[1] + 1;
+    work[pending++] = piece;
+  }
+  piece.topLeft.axes[1] = overlap->topLeft.axes[1];
+  piece.botRight.axes[1] = overlap->botRight.axes[1];
+  if (r->topLeft.axes[0] < overlap->topLeft.axes[0]) { /* left */
+    piece.topLeft.axes[0] = r->topLeft.axes[0];
+    piece.botRight.axes[0] = overlap->topLeft.axes[0] - 1;
+    work[pending++] = piece;
+  }
+  if (r->botRight.axes[0] > overlap->botRight.axes[0]) { /* right */
+    piece.topLeft.axes[0] = overlap->botRight.axes[0] + 1;
+    piece.botRight.axes[0] = r->botRight.axes[0];
+    work[pending++] = piece;
+  }
+  return pending;
+}
+
+// true if the bounding box of r and regions[i] overlaps any other region
+static int
+mergeOverlaps(const DamageList *damage, u_char i, const Region *r)
+{
+  Region rUnion, overlap;
+  u_char j;
+  regionUnion(&rUnion, &damage->regions[i], r);
+  for (j = 0; j < damage->count; j++)
+    if (j != i && regionIntersect(&overlap, &damage->regions[j], &rUnion))
+      return 1;
+  return 0;
+}
+
+void
+damageAdd(DamageList *damage, const Region *region)
+{
+  Region work[DAMAGE_WORK];
+  u_char pending = 0;
+  int area = regionArea(region);
+  if (!area)
+    return;
+#ifdef SHAPE_STATS
+  damage->added.pixelsRaw += area;
+#endif
+  work[pending++] = *region;
+
+  while (pending) {
+    Region r = work[--pending];
+    u_char i, absorb = 0;	/* absorb: merge whatever r overlaps */
+  retry:
+    for (i = 0; i < damage->count; i++) {
+      Region *e = &damage->regions[i], overlap;
+      int overlaps = regionIntersect(&overlap, e, &r);
+      if (overlaps && regionArea(&overlap) == regionArea(&r))
+	goto placed;		/* already damaged */
+      if (overlaps && pending + 4 > DAMAGE_WORK)
+	absorb = 1;		/* no room for pieces */
+      if ((overlaps && absorb) ||
+	  (mergeWaste(e, &r) <= DAMAGE_SETAREA_COST && !mergeOverlaps(damage, i, &r))) {
+	regionUnion(&r, e, &r);
+	damageRemove(damage, i);
+	goto retry;
+      }
+      if (overlaps) {		/* keep only what e doesn't cover */
+	pending = damageSplit(work, pending, &r, &overlap);
+	goto placed;
+      }
+    }
+    if (damage->count == DAMAGE_MAX_REGIONS) { /* full: merge the cheapest */
+      u_char best = 0;
+      int bestWaste = mergeWaste(&damage->regions[0], &r);
+      for (i = 1; i < damage->count; i++) {
+	int waste = mergeWaste(&damage->regions[i], &r);
+	if (waste < bestWaste) {
+	  best = i;
+	  bestWaste = waste;
+	}
+      }
+      regionUnion(&r, &damage->regions[best], &r);
+      damageRemove(damage, best);
+      absorb = 1;
+      goto retry;
+    }
+    damage->regions[damage->count++] = r;
+  placed:
+    ;
+  }
+}
+
+/* Draws the list if it has less than DAMAGE_LAYER_ROOM free, so damageAdd
+ * rarely has to merge rectangles to fit
+ */
+static void
+damageMakeRoom(DamageList *damage)
+{
+  if (damage->count > DAMAGE_MAX_REGIONS - DAMAGE_LAYER_ROOM)
+    damageFlush(damage);
+}
+
+void
+damageAddLayer(DamageList *damage, const Layer *l)
+{
+  Region bounds;
+  damageMakeRoom(damage);
+  if (l->flags & LAYER_DISCONTINUOUS) { /* old and new positions apart */
+    abShapeGetBounds(l->abShape, &l->posLast, &bounds);
+    regionClipScreen(&bounds);
+    damageAdd(damage, &bounds);
+    abShapeGetBounds(l->abShape, &l->pos, &bounds);
+    regionClipScreen(&bounds);
+  } else
+    layerGetBounds(l, &bounds);
+  damageAdd(damage, &bounds);
+}
+
+// true if col lies within one of n spans
+static int
+spansCover(const Span *spans, int n, int col)
+{
+  while (n--)
+    if (spans[n].start <= col && col <= spans[n].end)
+      return 1;
+  return 0;
+}
+
+// first column past col where coverage by n spans may change, limit if none before it
+static int
+spansNextEdge(const Span *spans, int n, int col, int limit)
+{
+  while (n--) {
+    if (spans[n].start > col && spans[n].start < limit)
+      limit = spans[n].start;
+    if (spans[n].end >= col && spans[n].end < limit - 1)
+      limit = spans[n].end + 1;
+  }
+  return limit;
+}
+
+// damage [start, end] of row, within bounds' columns
+static void
+damageAddSpan(DamageList *damage, const Region *bounds, int row, int start, int end)
+{
+  Region changed;
+  changed.topLeft.axes[0] = start > bounds->topLeft.axes[0] ? start : bounds->topLeft.axes[0];
+  changed.botRight.axes[0] = end < bounds->botRight.axes[0] ? end : bounds->botRight.axes[0];
+  changed.topLeft.axes[1] = changed.botRight.axes[1] = row;
+  damageAdd(damage, &changed);
+}
+
+/* A row's spans at posLast and pos.  Not on the stack:  the list may be
+ * drawn (damageFlush) from within damageAddLayerDelta.
+ */
+static Span lastSpans[SHAPE_MAX_SPANS], curSpans[SHAPE_MAX_SPANS];
+
+void
+damageAddLayerDelta(DamageList *damage, const Layer *l)
+{
+  Region bounds, lastBounds;
+  int row;
+  if (l->flags & LAYER_DISCONTINUOUS) {
+    damageAddLayer(damage, l);
+    return;
+  }
+  abShapeGetBounds(l->abShape, &l->posLast, &lastBounds);
+  abShapeGetBounds(l->abShape, &l->pos, &bounds);
+  regionUnion(&bounds, &bounds, &lastBounds);
+  regionClipScreen(&bounds);
+  for (row = bounds.topLeft.axes[1]; row <= bounds.botRight.axes[1]; row++) {
+    int nLast, nCur, col, start = 0, end = -1;
+    damageMakeRoom(damage);	/* for the row's pieces */
+    nLast = abShapeRowSpans(l->abShape, &l->posLast, row, lastSpans);
+    nCur = abShapeRowSpans(l->abShape, &l->pos, row, curSpans);
+    if (nLast < 0 || nCur < 0) {	/* can't tell, redraw the whole row */
+      damageAddSpan(damage, &bounds, row, bounds.topLeft.axes[0], bounds.botRight.axes[0]);
+      continue;
+    }
+    for (col = bounds.topLeft.axes[0]; col <= bounds.botRight.axes[0]; ) {
+      int next = spansNextEdge(lastSpans, nLast, col, bounds.botRight.axes[0] + 1);
+      next = spansNextEdge(curSpans, nCur, col, next);
+      if (spansCover(lastSpans, nLast, col) != spansCover(curSpans, nCur, col)) {
+	/* covered before or after, not both */
+	if (end + 1 != col) {	/* not contiguous with the pending piece */
+	  if (end >= start)
+	    damageAddSpan(damage, &bounds, row, start, end);
+	  start = col;
+	}
+	end = next - 1;
+      }
+      col = next;
+    }
+    if (end >= start)
+      damageAddSpan(damage, &bounds, row, start, end);
+  }
+}
+
+void
+damageDraw(DamageList *damage)
+{
+  damageFlush(damage);
+#ifdef SHAPE_STATS
+  damage->frame = damage->added;
+  damage->added.pixelsRaw = damage->added.pixels = 0;
+  damage->added.regions = 0;
+#endif
+}
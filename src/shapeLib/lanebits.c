@@ -0,0 +1,34 @@
+#include "shape.h"
+
+/* bits first..last (0..15) of a word */
+#define LANEBITS_MASK(first, last) ((0xffffu >> (15 - (last))) & (0xffffu << (first)))
+
+void
+laneBitsClear(LaneBits *lane)
+{
+  u_char word;
+  for (word = 0; word < LANEBITS_WORDS; word++)
+    lane->words[word] = 0;
+}
+
+void
+laneBitsSet(LaneBits *lane, int start, int end)
+{
+  u_char word;
+  if (start < 0) start = 0;
+  if (end >= LANEBITS_COLS) end = LANEBITS_COLS - 1;
+  for (word = start >> 4; start <= end; start = ++word << 4)
+    lane->words[word] |= LANEBITS_MASK(start & 15, (word << 4) + 15 <= end ? 15 : end & 15);
+}
+
+int
+laneBitsAny(const LaneBits *lane, int start, int end)
+{
+  u_char word;
+  if (start < 0) start = 0;
+  if (end >= LANEBITS_COLS) end = LANEBITS_COLS - 1;
+  for (word = start >> 4; start <= end; start = ++word << 4)
+    if (lane->words[word] & LANEBITS_MASK(start & 15, (word << 4) + 15 <= end ? 15 : end & 15))
+      return 1;
+  return 0;
+}
@@ -2,28 +2,433 @@
 #include "lcddraw.h"
 #include "shape.h"
 
+/** Most spans collected for one row before it is probed per pixel.  Each
+ *  takes 6 bytes of drawRegion's stack frame; frogger's rows need at most
+ *  3 (a car, the frog and a lane), busier scenes probe the rest.
+ */
+#ifndef LAYER_ROW_SPANS
+#define LAYER_ROW_SPANS 4
+#endif
+
+/** A span of a row covered by a layer of the given color */
+typedef struct {
+  int start, end;
+  u_int color;
+} ColorSpan;
+
+static u_int runColor, runLength; /* pending run of identically colored pixels */
+
+#ifdef SHAPE_STATS
+LayerStats layerStats;
+#define LAYER_COUNT(counter, n) (layerStats.counter += (n))
+#else
+#define LAYER_COUNT(counter, n)
+#endif
+
+static void
+runFlush()
+{
+  lcd_writeColorRun(runColor, runLength);
+  runLength = 0;
+}
+
+/* Runs continue across rows since the area is written row after row */
+static void
+runEmit(u_int color, int count)
+{
+  if (runLength && color != runColor)
+    runFlush();
+  runColor = color;
+  runLength += count;
+}
+
+u_int
+layerProbe(Layer *layers, const Vec2 *pixelPos)
+{
+  Layer *probeLayer;
+  for (probeLayer = layers; probeLayer; probeLayer = probeLayer->next) {
+    if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, pixelPos))
+      return probeLayer->color;
+  } // for checking all layers at col, row
+  return bgColor;
+}
+
+/** Static background table:  rows of the static layers at the bottom of a
+ *  layer list, grouped into bands of rows with the same content.
+ */
+typedef struct {
+  u_char rowEnd;		/* last row of the band */
+  u_char kind;			/* BG_* */
+  u_int color;			/* of BG_UNIFORM rows */
+} BgBand;
+
+#define BG_EMPTY 0		/* no static layer on these rows: bgColor */
+#define BG_UNIFORM 1		/* every column is color */
+#define BG_MIXED 2		/* static layers must be resolved */
+
+static Layer *bgLayers;		/* first of the static layers in the table */
+static BgBand bgBands[BG_MAX_BANDS];
+static u_char bgBandCount;
+
+static const BgBand *
+bgBandAt(int row)
+{
+  u_char i;
+  for (i = 0; i < bgBandCount - 1 && bgBands[i].rowEnd < row; i++)
+    ;
+  return &bgBands[i];
+}
+
+/* Appends spans of row within [colMin, colMax] covered by shape at pos.
+ * Returns the new count, or -1 if the spans can't be collected.
+ */
+static int
+shapeSpans(const AbShape *shape, const Vec2 *pos, u_int color, int row,
+	   int colMin, int colMax, ColorSpan *spans, int count)
+{
+  Span shapeSpans[SHAPE_MAX_SPANS];
+  int i, n = abShapeRowSpans(shape, pos, row, shapeSpans);
+  if (n < 0)
+    return -1;
+  for (i = 0; i < n; i++) {
+    int start = shapeSpans[i].start, end = shapeSpans[i].end;
+    if (start < colMin) start = colMin;
+    if (end > colMax) end = colMax;
+    if (start > end)
+      continue;
+    if (count == LAYER_ROW_SPANS)
+      return -1;
+    spans[count].start = start;
+    spans[count].end = end;
+    spans[count].color = color;
+    count++;
+  }
+  return count;
+}
+
+static int
+layerSpans(const Layer *layer, int row, int colMin, int colMax,
+	   ColorSpan *spans, int count)
+{
+  return shapeSpans(layer->abShape, &layer->pos, layer->color, row,
+		    colMin, colMax, spans, count);
+}
+
+/* Appends spans of row for layers up to (not including) stop, topmost first.
+ * Returns the new count, or -1 if some layer's spans can't be collected.
+ */
+static int
+rowCollect(Layer *layers, Layer *stop, int row, int colMin, int colMax,
+	   ColorSpan *spans, int count)
+{
+  for (; layers != stop && count >= 0; layers = layers->next)
+    count = layerSpans(layers, row, colMin, colMax, spans, count);
+  return count;
+}
+
+/* Index of the topmost span covering col, count if there is none */
+static int
+rowTop(const ColorSpan *spans, int count, int col)
+{
+  int top;
+  for (top = 0; top < count; top++)
+    if (spans[top].start <= col && col <= spans[top].end)
+      break;
+  return top;
+}
+
+/* A run starting at col ends at runEnd or where a span above top starts */
+static int
+rowRunEnd(const ColorSpan *spans, int top, int col, int runEnd)
+{
+  int i;
+  for (i = 0; i < top; i++) {
+    if (spans[i].start > col && spans[i].start <= runEnd)
+      runEnd = spans[i].start - 1;
+  }
+  return runEnd;
+}
+
+/* Emits [colMin, colMax] as runs.  A run takes the color of the topmost span
+ * covering its first pixel (or background) and ends where that span ends or
+ * where a span above it starts.
+ */
+static void
+rowResolve(const ColorSpan *spans, int count, int colMin, int colMax,
+	   u_int background)
+{
+  int col = colMin;
+  while (col <= colMax) {
+    int top = rowTop(spans, count, col), runEnd;
+    u_int color = background;
+    if (top < count) {
+      color = spans[top].color;
+      runEnd = rowRunEnd(spans, top, col, spans[top].end);
+    } else
+      runEnd = rowRunEnd(spans, count, col, colMax);
+    runEmit(color, runEnd - col + 1);
+    col = runEnd + 1;
+  }
+}
+
+static void
+rowProbe(Layer *layers, int row, int colMin, int colMax)
+{
+  Vec2 pixelPos = {{colMin, row}};
+  LAYER_COUNT(pixelsProbed, colMax - colMin + 1);
+  for (; pixelPos.axes[0] <= colMax; pixelPos.axes[0]++)
+    runEmit(layerProbe(layers, &pixelPos), 1);
+}
+
 void
-layerDraw(Layer *layers)
+layerBgBuild(Layer *layers)
 {
-  int row, col;
+  ColorSpan spans[LAYER_ROW_SPANS];
+  int row;
+  bgLayers = 0;
+  bgBandCount = 0;
+  for (; layers; layers = layers->next) { /* find the all-static tail */
+    if (!(layers->flags & LAYER_STATIC))
+      bgLayers = 0;
+    else if (!bgLayers)
+      bgLayers = layers;
+  }
+  if (!bgLayers)
+    return;
   for (row = 0; row < screenHeight; row++) {
-    lcd_setArea(0, row, screenWidth-1, row);
-    for (col = 0; col < screenWidth; col++) {
-      Vec2 pixelPos = {col, row};
-      u_int color = bgColor;
-      Layer *probeLayer;
-      for (probeLayer = layers; probeLayer; probeLayer = probeLayer->next) {
-	if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, &pixelPos)) {
-	  color = probeLayer->color;
-	  break; 
-	} /* if check */
-      } // for checking all layers at col, row
-      lcd_writeColor(color); 
-    } // for col
+    BgBand band = {row, BG_MIXED, 0};
+    int count = rowCollect(bgLayers, 0, row, 0, screenWidth-1, spans, 0);
+    if (count == 0)
+      band.kind = BG_EMPTY;
+    else if (count > 0) {
+      int top = rowTop(spans, count, 0);
+      if (top < count && rowRunEnd(spans, top, 0, spans[top].end) == screenWidth-1) {
+	band.kind = BG_UNIFORM;
+	band.color = spans[top].color;
+      }
+    }
+    if (bgBandCount) {
+      BgBand *last = &bgBands[bgBandCount-1];
+      if (last->kind == band.kind && (band.kind != BG_UNIFORM || last->color == band.color)) {
+	last->rowEnd = row;
+	continue;
+      }
+      if (bgBandCount == BG_MAX_BANDS) { /* out of bands: resolve the rest */
+	last->kind = BG_MIXED;
+	last->rowEnd = row;
+	continue;
+      }
+    }
+    bgBands[bgBandCount++] = band;
+  }
+}
+
+/** Bounds of the topmost (dynamic) layers, computed once per draw */
+typedef struct {
+  Layer *layer;
+  Region bounds;
+} CullEntry;
+
+static CullEntry cullEntries[LAYER_CULL_MAX];
+static u_char cullCount;
+static Layer *cullRest;		/* first layer without an entry */
+
+static void
+cullLayers(Layer *layers)
+{
+  cullCount = 0;
+  for (; layers && layers != bgLayers && cullCount < LAYER_CULL_MAX; layers = layers->next) {
+    cullEntries[cullCount].layer = layers;
+    abShapeGetBounds(layers->abShape, &layers->pos, &cullEntries[cullCount].bounds);
+    cullCount++;
+  }
+  cullRest = layers;
+}
+
+static void
+drawRegion(Layer *layers, Layer *bg, const Region *region)
+{
+  int row;
+  int colMin = region->topLeft.axes[0], colMax = region->botRight.axes[0];
+  ColorSpan spans[LAYER_ROW_SPANS];
+  u_char visible[LAYER_CULL_MAX], visibleCount = 0, i;
+  for (i = 0; i < cullCount; i++) { /* layers within region */
+    Region overlap;
+    if (regionIntersect(&overlap, &cullEntries[i].bounds, region))
+      visible[visibleCount++] = i;
+  }
+  lcd_appendArea(colMin, region->topLeft.axes[1], colMax, region->botRight.axes[1]);
+  LAYER_COUNT(pixelsWritten, regionArea(region));
+  for (row = region->topLeft.axes[1]; row <= region->botRight.axes[1]; row++) {
+    Layer *stop = 0;		/* resolve static layers from the table */
+    u_int background = bgColor;
+    int count = 0;
+    if (bg) {
+      const BgBand *band = bgBandAt(row);
+      if (band->kind != BG_MIXED)
+	stop = bg;
+      if (band->kind == BG_UNIFORM)
+	background = band->color;
+    }
+    for (i = 0; i < visibleCount && count >= 0; i++) { /* layers on row */
+      const CullEntry *entry = &cullEntries[visible[i]];
+      if (row >= entry->bounds.topLeft.axes[1] && row <= entry->bounds.botRight.axes[1])
+	count = layerSpans(entry->layer, row, colMin, colMax, spans, count);
+    }
+    if (count >= 0)
+      count = rowCollect(cullRest, stop, row, colMin, colMax, spans, count);
+    if (count >= 0)
+      rowResolve(spans, count, colMin, colMax, background);
+    else
+      rowProbe(layers, row, colMin, colMax);
   } // for row
-} 
+  runFlush();
+}
 
+void
+layerDrawRegions(Layer *layers, const Region *regions, u_char count)
+{
+  Layer *bg;
+  for (bg = layers; bg && bg != bgLayers; bg = bg->next) /* table applies? */
+    ;
+  cullLayers(layers);
+  for (; count; count--, regions++) {
+    if (regions->topLeft.axes[0] <= regions->botRight.axes[0] &&
+	regions->topLeft.axes[1] <= regions->botRight.axes[1])
+      drawRegion(layers, bg, regions);
+  }
+  lcd_flush();
+}
 
+void
+layerDrawRegion(Layer *layers, const Region *region)
+{
+  layerDrawRegions(layers, region, 1);
+}
+
+void
+layerDraw(Layer *layers)
+{
+  Region screen = {{{0, 0}}, {{screenWidth-1, screenHeight-1}}};
+  layerDrawRegion(layers, &screen);
+}
+
+
+
+/** LayerSet */
+
+/** Rows each shape of a LayerSet reaches, about its center, found once
+ *  per draw (on the stack)
+ */
+typedef struct {
+  signed char top[LAYERSET_SHAPES], bottom[LAYERSET_SHAPES];
+} SetExtents;
+
+static void
+setExtents(const LayerSet *set, SetExtents *extents)
+{
+  u_char i;
+  for (i = 0; i < set->shapeCount; i++) {
+    Region bounds;		/* at screenCenter, as getBounds may clip */
+    abShapeGetBounds(set->shapes[i], &screenCenter, &bounds);
+    extents->top[i] = bounds.topLeft.axes[1] - screenCenter.axes[1];
+    extents->bottom[i] = bounds.botRight.axes[1] - screenCenter.axes[1];
+  }
+}
+
+/* Spans of row from the layers of set reaching it, topmost first */
+static int
+setCollect(const LayerSet *set, const SetExtents *extents, int row,
+	   int colMin, int colMax, ColorSpan *spans)
+{
+  u_char i;
+  int count = 0;
+  for (i = 0; i < set->count && count >= 0; i++) {
+    u_char id = set->shapeIds[i];
+    int dRow = row - layerSetRow(set, i);
+    Vec2 pos;
+    if (layerSetHidden(set, i) ||
+	dRow < extents->top[id] || dRow > extents->bottom[id])
+      continue;			/* decided from the row array alone */
+    pos.axes[0] = layerSetCol(set, i);
+    pos.axes[1] = layerSetRow(set, i);
+    count = shapeSpans(set->shapes[id], &pos, set->colors[i], row,
+		       colMin, colMax, spans, count);
+  }
+  return count;
+}
+
+u_int
+layerSetProbe(const LayerSet *set, const Vec2 *pixelPos)
+{
+  u_char i;
+  for (i = 0; i < set->count; i++) {
+    Vec2 pos = {{layerSetCol(set, i), layerSetRow(set, i)}};
+    if (!layerSetHidden(set, i) && abShapeCheck(set->shapes[set->shapeIds[i]], &pos, pixelPos))
+      return set->colors[i];
+  }
+  return bgColor;
+}
+
+void
+layerSetGetBounds(const LayerSet *set, u_char i, Region *bounds)
+{
+  Vec2 pos = {{layerSetCol(set, i), layerSetRow(set, i)}};
+  if (layerSetHidden(set, i)) {	/* empty */
+    bounds->topLeft = screenSize;
+    bounds->botRight = vec2Zero;
+    return;
+  }
+  abShapeGetBounds(set->shapes[set->shapeIds[i]], &pos, bounds);
+  regionClipScreen(bounds);
+}
+
+int
+layerSetMove(LayerSet *set, u_char i, int col, int row)
+{
+  if (col < -LAYERSET_BIAS || col > LAYERSET_MAX ||
+      row < -LAYERSET_BIAS || row > LAYERSET_MAX) {
+    set->cols[i] = LAYERSET_HIDDEN;
+    return 0;
+  }
+  set->cols[i] = col + LAYERSET_BIAS;
+  set->rows[i] = row + LAYERSET_BIAS;
+  return 1;
+}
+
+void
+layerSetDrawRegion(const LayerSet *set, const Region *region)
+{
+  int row;
+  int colMin = region->topLeft.axes[0], colMax = region->botRight.axes[0];
+  ColorSpan spans[LAYER_ROW_SPANS];
+  SetExtents extents;
+  if (colMin > colMax || region->topLeft.axes[1] > region->botRight.axes[1])
+    return;
+  setExtents(set, &extents);
+  lcd_appendArea(colMin, region->topLeft.axes[1], colMax, region->botRight.axes[1]);
+  LAYER_COUNT(pixelsWritten, regionArea(region));
+  for (row = region->topLeft.axes[1]; row <= region->botRight.axes[1]; row++) {
+    int count = setCollect(set, &extents, row, colMin, colMax, spans);
+    if (count >= 0)
+      rowResolve(spans, count, colMin, colMax, bgColor);
+    else {
+      Vec2 pixelPos = {{colMin, row}};
+      LAYER_COUNT(pixelsProbed, colMax - colMin + 1);
+      for (; pixelPos.axes[0] <= colMax; pixelPos.axes[0]++)
+	runEmit(layerSetProbe(set, &pixelPos), 1);
+    }
+  }
+  runFlush();
+  lcd_flush();
+}
+
+void
+layerSetDraw(const LayerSet *set)
+{
+  Region screen = {{{0, 0}}, {{screenWidth-1, screenHeight-1}}};
+  layerSetDrawRegion(set, &screen);
+}
 
 void
 layerGetBounds(const Layer *l, Region *bounds)
@@ -35,10 +440,22 @@ layerGetBounds(const Layer *l, Region *bounds)
   regionClipScreen(bounds);
 }
 
+void
+layerCommit(Layer *l)
+{
+  u_char teleported = l->flags & LAYER_TELEPORT;
+  l->posLast = l->pos;
+  l->pos = l->posNext;
+  l->flags &= ~(LAYER_TELEPORT | LAYER_DISCONTINUOUS);
+  if (teleported)
+    l->flags |= LAYER_DISCONTINUOUS;
+}
+
 void
 layerInit(Layer *layer)
 {
   for (; layer; layer = layer->next)
-    layer->posLast = layer->posNext = layer->pos;
+    if (!(layer->flags & LAYER_STATIC)) /* may be const */
+      layer->posLast = layer->posNext = layer->pos;
 }
 
@@ -0,0 +1,105 @@
+#include "shape.h"
+
+/* set the mask bits of columns start..end (relative to the mask) of row */
+static void
+maskSetSpan(AbMask *mask, u_char *rowBits, int start, int end)
+{
+  int col;
+  if (start < 0) start = 0;
+  if (end >= mask->width) end = mask->width - 1;
+  for (col = start; col <= end; col++)
+    rowBits[col >> 3] |= 0x80 >> (col & 7);
+}
+
+int
+abMaskInit(AbMask *mask, const AbShape *shape, u_char *bits, int size)
+{
+  Region bounds;
+  int width, height, rowBytes, row, col, i;
+  /* rasterized at the screen's center, as getBounds may clip to the screen */
+  abShapeGetBounds(shape, &screenCenter, &bounds);
+  width = bounds.botRight.axes[0] - bounds.topLeft.axes[0] + 1;
+  height = bounds.botRight.axes[1] - bounds.topLeft.axes[1] + 1;
+  rowBytes = (width + 7) / 8;
+  if (width < 1 || height < 1 || width > 255 || height > 255
+      || ABMASK_BYTES(width, height) > size)
+    return -1;
+  mask->getBounds = abMaskGetBounds;
+  mask->check = abMaskCheck;
+  mask->rowSpans = abMaskRowSpans;
+  vec2Sub(&mask->offset, &bounds.topLeft, &screenCenter);
+  mask->width = width;
+  mask->height = height;
+  mask->bits = bits;
+  for (row = 0; row < height; row++) {
+    u_char *rowBits = bits + row * rowBytes;
+    Span spans[SHAPE_MAX_SPANS];
+    int y = row + bounds.topLeft.axes[1];
+    int n = abShapeRowSpans(shape, &screenCenter, y, spans);
+    for (col = 0; col < rowBytes; col++)
+      rowBits[col] = 0;
+    if (n >= 0) {
+      for (i = 0; i < n; i++)
+	maskSetSpan(mask, rowBits, spans[i].start - bounds.topLeft.axes[0],
+		    spans[i].end - bounds.topLeft.axes[0]);
+    } else {			/* shape can't tell, probe it */
+      for (col = 0; col < width; col++) {
+	Vec2 pixel = {{col + bounds.topLeft.axes[0], y}};
+	if (abShapeCheck(shape, &screenCenter, &pixel))
+	  maskSetSpan(mask, rowBits, col, col);
+      }
+    }
+  }
+  return ABMASK_BYTES(width, height);
+}
+
+void
+abMaskGetBounds(const AbMask *mask, const Vec2 *centerPos, Region *bounds)
+{
+  vec2Add(&bounds->topLeft, centerPos, &mask->offset);
+  bounds->botRight.axes[0] = bounds->topLeft.axes[0] + mask->width - 1;
+  bounds->botRight.axes[1] = bounds->topLeft.axes[1] + mask->height - 1;
+}
+
+int
+abMaskCheck(const AbMask *mask, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int col = pixel->axes[0] - centerPos->axes[0] - mask->offset.axes[0];
+  int row = pixel->axes[1] - centerPos->axes[1] - mask->offset.axes[1];
+  if (col < 0 || col >= mask->width || row < 0 || row >= mask->height)
+    return 0;
+  return (mask->bits[row * ((mask->width + 7) >> 3) + (col >> 3)] >> (7 - (col & 7))) & 1;
+}
+
+// runs of set bits on row, a whole byte at a time where it's all one way
+int
+abMaskRowSpans(const AbMask *mask, const Vec2 *centerPos, int row, Span *spans)
+{
+  int left = centerPos->axes[0] + mask->offset.axes[0];
+  int width = mask->width, col = 0, n = 0, inRun = 0;
+  const u_char *rowBits;
+  row -= centerPos->axes[1] + mask->offset.axes[1];
+  if (row < 0 || row >= mask->height)
+    return 0;
+  rowBits = mask->bits + row * ((width + 7) >> 3);
+  while (col < width) {
+    u_char byte = rowBits[col >> 3];
+    if ((col & 7) == 0 && byte == (inRun ? 0xff : 0x00)) {
+      col += 8;			/* no edge in this byte */
+      continue;
+    }
+    if (((byte >> (7 - (col & 7))) & 1) != inRun) {
+      if (inRun)
+	spans[n++].end = left + col - 1;
+      else if (n == SHAPE_MAX_SPANS)
+	return -1;
+      else
+	spans[n].start = left + col;
+      inRun = !inRun;
+    }
+    col++;
+  }
+  if (inRun)
+    spans[n++].end = left + width - 1;
+  return n;
+}
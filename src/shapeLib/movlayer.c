@@ -0,0 +1,43 @@
+#include "shape.h"
+#ifdef __MSP430__
+#include "sr.h"			/* from timerLib */
+#endif
+
+static DamageList movDamage;	/* pixels to redraw this frame */
+
+int
+movLayerStep(MovLayer *movLayer, Vec2 *newPos)
+{
+  const Vec2 *pos = &movLayer->layer->posNext;
+  u_char axis;
+  for (axis = 0; axis < 2; axis++) {
+    /* floor:  a negative velocity borrows from the whole pixels */
+    int q = movLayer->frac[axis] + movLayer->velocity.axes[axis];
+    newPos->axes[axis] = pos->axes[axis] + (q >> MOV_FRAC_BITS);
+    movLayer->frac[axis] = q & ((1 << MOV_FRAC_BITS) - 1);
+  }
+  return newPos->axes[0] != pos->axes[0] || newPos->axes[1] != pos->axes[1];
+}
+
+void
+movLayerDraw(MovLayer *movLayers, Layer *layers)
+{
+  MovLayer *movLayer;
+#ifdef __MSP430__
+  int sr = get_sr();
+  and_sr(~8);			/* GIE off: advances run in interrupts */
+#endif
+  for (movLayer = movLayers; movLayer; movLayer = movLayer->next)
+    layerCommit(movLayer->layer);
+#ifdef __MSP430__
+  or_sr(sr & 8);		/* GIE back as it was */
+#endif
+  if (movDamage.layers != layers)
+    damageInit(&movDamage, layers);
+  for (movLayer = movLayers; movLayer; movLayer = movLayer->next) {
+    Layer *l = movLayer->layer;
+    if (l->pos.axes[0] != l->posLast.axes[0] || l->pos.axes[1] != l->posLast.axes[1])
+      damageAddLayerDelta(&movDamage, l);
+  }
+  damageDraw(&movDamage);
+}
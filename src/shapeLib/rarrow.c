@@ -37,4 +37,25 @@ abRArrowGetBounds(const AbRArrow *arrow, const Vec2 *centerPos, Region *bounds)
   bounds->botRight.axes[1] = centerPos->axes[1] + halfSize;
 }
 
-
+/** Spans function required by AbShape
+ *  abRArrowRowSpans computes the single span of a right arrow on row
+ *  (tip rows and stem rows overlap, so each row is contiguous)
+ */
+int
+abRArrowRowSpans(const AbRArrow *arrow, const Vec2 *centerPos, int row, Span *spans)
+{
+  int size = arrow->size;
+  int halfSize = size/2, quarterSize = halfSize/2;
+  int colMax;			/* columns are measured leftwards from the tip */
+  row -= centerPos->axes[1];
+  row = (row >= 0) ? row : -row;/* row = |row| */
+  if (row <= quarterSize)	/* tip and stem */
+    colMax = size;
+  else if (row <= halfSize)	/* tip only */
+    colMax = halfSize;
+  else
+    return 0;
+  spans[0].start = centerPos->axes[0] - colMax;
+  spans[0].end = centerPos->axes[0] - row;
+  return 1;
+}
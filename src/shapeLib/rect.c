@@ -22,6 +22,18 @@ void abRectGetBounds(const AbRect *rect, const Vec2 *centerPos, Region *bounds)
   vec2Add(&bounds->botRight, centerPos, &rect->halfSize);
 }
 
+// single span covering the rect's width on rows within its height
+int
+abRectRowSpans(const AbRect *rect, const Vec2 *centerPos, int row, Span *spans)
+{
+  int dRow = row - centerPos->axes[1], halfHeight = rect->halfSize.axes[1];
+  if (dRow < -halfHeight || dRow > halfHeight)
+    return 0;
+  spans[0].start = centerPos->axes[0] - rect->halfSize.axes[0];
+  spans[0].end = centerPos->axes[0] + rect->halfSize.axes[0];
+  return 1;
+}
+
 
 
 // true if pixel is in rect centerPosed at rectPos
@@ -49,5 +61,23 @@ void abRectOutlineGetBounds(const AbRectOutline *rect, const Vec2 *centerPos, Re
   vec2Add(&bounds->botRight, centerPos, &rect->halfSize);
 }
 
+// full width on top & bottom edges, left & right pixels in between
+int
+abRectOutlineRowSpans(const AbRectOutline *rect, const Vec2 *centerPos, int row, Span *spans)
+{
+  int dRow = row - centerPos->axes[1], halfHeight = rect->halfSize.axes[1];
+  int left = centerPos->axes[0] - rect->halfSize.axes[0];
+  int right = centerPos->axes[0] + rect->halfSize.axes[0];
+  if (dRow < -halfHeight || dRow > halfHeight)
+    return 0;
+  if (dRow == -halfHeight || dRow == halfHeight) {
+    spans[0].start = left; spans[0].end = right;
+    return 1;
+  }
+  spans[0].start = spans[0].end = left;
+  spans[1].start = spans[1].end = right;
+  return 2;
+}
+
 
 
@@ -15,3 +15,21 @@ void regionClipScreen(Region *r)
   vec2Min(&r->botRight, &r->botRight, &screenSize);
 }
 
+// compute overlap of two regions, true if not empty
+int
+regionIntersect(Region *rIntersect, const Region *r1, const Region *r2)
+{
+  vec2Max(&rIntersect->topLeft, &r1->topLeft, &r2->topLeft);
+  vec2Min(&rIntersect->botRight, &r1->botRight, &r2->botRight);
+  return (rIntersect->topLeft.axes[0] <= rIntersect->botRight.axes[0] &&
+	  rIntersect->topLeft.axes[1] <= rIntersect->botRight.axes[1]);
+}
+
+// pixels within region (bounds included)
+int
+regionArea(const Region *r)
+{
+  int width = r->botRight.axes[0] - r->topLeft.axes[0] + 1;
+  int height = r->botRight.axes[1] - r->topLeft.axes[1] + 1;
+  return (width > 0 && height > 0) ? width * height : 0;
+}
@@ -4,6 +4,13 @@ const Vec2 screenSize = {screenWidth, screenHeight};
 const Vec2 screenCenter= {screenWidth/2, screenHeight/2};
 const Vec2 vec2Unit = {1,1}, vec2Zero = {0,0};;
 
+#ifdef SHAPE_STATS
+ShapeStats shapeStats;
+#define SHAPE_COUNT(counter) (shapeStats.counter++)
+#else
+#define SHAPE_COUNT(counter)
+#endif
+
 void
 shapeInit()
 {
@@ -13,12 +20,21 @@ shapeInit()
 void 
 abShapeGetBounds(const AbShape *s, const Vec2 *centerPos, Region *bounds)
 {
+  SHAPE_COUNT(getBounds);
   (*s->getBounds)(s, centerPos, bounds);
 }
 
 int
 abShapeCheck(const AbShape *s, const Vec2 *centerPos, const Vec2 *pixelLoc)
 {
+  SHAPE_COUNT(checks);
   return (*s->check)(s, centerPos, pixelLoc);
 }
 
+
+int
+abShapeRowSpans(const AbShape *s, const Vec2 *centerPos, int row, Span *spans)
+{
+  SHAPE_COUNT(rowSpans);
+  return (*s->rowSpans)(s, centerPos, row, spans);
+}
@@ -62,6 +62,27 @@ void regionUnion(Region *rUnion, const Region *r1, const Region *r2);
  */
 void regionClipScreen(Region *region);
 
+/** Computes the overlap of two regions.
+ *
+ *  \return True (1) if the regions overlap
+ */
+int regionIntersect(Region *rIntersect, const Region *r1, const Region *r2);
+
+/** Number of pixels in a region (0 if it is empty)
+ */
+int regionArea(const Region *region);
+
+/** A horizontal run of pixels on a single row
+ *
+ *  Both start and end columns are included in the span.
+ */
+typedef struct {
+  int start, end;
+} Span;
+
+/** Maximum number of spans an AbShape reports for a single row */
+#define SHAPE_MAX_SPANS 2
+
 /** This function initializes the screen
  *  vectors that are used by shapes
  *
@@ -72,17 +93,23 @@ void shapeInit();
 /** Effectively a base class for Abstract Shapes
  *  
  *  Abstract Shapes have a shape but no position or color.
- *  The first two fields MUST BE pointers to
+ *  The first three fields MUST BE pointers to
  *
  *  getBounds: A function that computes the bounding box for the AbShape
  *  when rendered at coordinate centerPos
  * 
  *  check: A function that determines if the AbShape contains pixelLoc when 
  *  rendered at centerPos
+ *
+ *  rowSpans: A function that stores the spans of pixels on the given row
+ *  covered by the AbShape when rendered at centerPos.  Returns the number
+ *  of spans (at most SHAPE_MAX_SPANS), or -1 if the row can't be
+ *  described by spans and must be probed pixel by pixel with check.
  */
 typedef struct AbShape_s {		/* base type for all abstrct shapes */
   void (*getBounds)(const struct AbShape_s *shape, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbShape_s *shape, const Vec2 *centerPos, const Vec2 *pixelLoc);
+  int (*rowSpans)(const struct AbShape_s *shape, const Vec2 *centerPos, int row, Span *spans);
 } AbShape;
 
 /** Computes bounding box of abShape in screen coordinates 
@@ -102,6 +129,27 @@ void abShapeGetBounds(const AbShape *s, const Vec2 *centerPos, Region *bounds);
  */
 int abShapeCheck(const AbShape *shape, const Vec2 *centerPos, const Vec2 *pixelLoc);
 
+/** Compute the spans of row covered by the abShape centered at centerPos
+ *
+ *  \param shape (in) The abstract shape
+ *  \param centerPos (in) The Vec2 specifying the center position of the shape
+ *  \param row (in) The screen row
+ *  \param spans (out) Room for SHAPE_MAX_SPANS spans, in screen columns
+ *  \return The number of spans stored, or -1 if row must be probed per pixel
+ */
+int abShapeRowSpans(const AbShape *shape, const Vec2 *centerPos, int row, Span *spans);
+
+#ifdef SHAPE_STATS
+/** Calls through the abShape functions above, counted when shapeLib is
+ *  built with SHAPE_STATS (as on the host, see bench/)
+ */
+typedef struct {
+  unsigned long getBounds, checks, rowSpans;
+} ShapeStats;
+
+extern ShapeStats shapeStats;
+#endif
+
 /** An AbShape Right Arrow with filled tip
  *
  *  size: width of the arrow.  Tip is a triangle with width=1/2 size.
@@ -110,6 +158,7 @@ int abShapeCheck(const AbShape *shape, const Vec2 *centerPos, const Vec2 *pixelL
 typedef struct AbRArrow_s {
   void (*getBounds)(const struct AbRArrow_s *shape, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbRArrow_s *shape, const Vec2 *centerPos, const Vec2 *pixelLoc);
+  int (*rowSpans)(const struct AbRArrow_s *shape, const Vec2 *centerPos, int row, Span *spans);
   int size;
 } AbRArrow;
 
@@ -121,6 +170,10 @@ void abRArrowGetBounds(const AbRArrow *arrow, const Vec2 *centerPos, Region *bou
  */
 int abRArrowCheck(const AbRArrow *arrow, const Vec2 *centerPos, const Vec2 *pixel);
 
+/** As required by AbShape
+ */
+int abRArrowRowSpans(const AbRArrow *arrow, const Vec2 *centerPos, int row, Span *spans);
+
 /** AbShape rectangle
  *
  *  Vector halfSize must be to first quadrant (both axes non-negative).  
@@ -129,6 +182,7 @@ int abRArrowCheck(const AbRArrow *arrow, const Vec2 *centerPos, const Vec2 *pixe
 typedef struct AbRect_s {
   void (*getBounds)(const struct AbRect_s *rect, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbRect_s *shape, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*rowSpans)(const struct AbRect_s *shape, const Vec2 *centerPos, int row, Span *spans);
   const Vec2 halfSize;	
 } AbRect;
 
@@ -140,6 +194,10 @@ void abRectGetBounds(const AbRect *rect, const Vec2 *centerPos, Region *bounds);
  */
 int abRectCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel);
 
+/** As required by AbShape
+ */
+int abRectRowSpans(const AbRect *rect, const Vec2 *centerPos, int row, Span *spans);
+
 typedef AbRect AbRectOutline;	/* same as AbRect */
 
 /** As required by AbShape
@@ -150,6 +208,61 @@ void abRectOutlineGetBounds(const AbRect *rect, const Vec2 *centerPos, Region *b
  */
 int abRectOutlineCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel);
 
+/** As required by AbShape
+ *  
+ *  Rows between the top and bottom edges are covered by two single-pixel spans.
+ */
+int abRectOutlineRowSpans(const AbRect *rect, const Vec2 *centerPos, int row, Span *spans);
+
+/** AbShape sprite mask:  another AbShape rasterized once by abMaskInit
+ *  into a bitmap, or a const bitmap built with ABMASK_SPAN_BYTE that
+ *  stays in flash, so checks and spans are bit tests instead of geometry.
+ *
+ *  bits holds height rows of (width+7)/8 bytes, most significant bit
+ *  leftmost.  offset is the top left pixel relative to centerPos.
+ *  Several layers may share one mask.
+ */
+typedef struct AbMask_s {
+  void (*getBounds)(const struct AbMask_s *mask, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbMask_s *mask, const Vec2 *centerPos, const Vec2 *pixel);
+  int (*rowSpans)(const struct AbMask_s *mask, const Vec2 *centerPos, int row, Span *spans);
+  Vec2 offset;
+  u_char width, height;
+  const u_char *bits;
+} AbMask;
+
+/** Bytes of mask bits needed for a shape of bounds width x height */
+#define ABMASK_BYTES(width, height) ((height) * (((width) + 7) / 8))
+
+/** Byte byte of a mask row with columns start..end set, for masks
+ *  defined at compile time (in flash) rather than by abMaskInit
+ */
+#define ABMASK_SPAN_BYTE(start, end, byte)				\
+  ((start) > 8*(byte) + 7 || (end) < 8*(byte) ? 0 :			\
+   (0xff >> ((start) > 8*(byte) ? (start) - 8*(byte) : 0)) &		\
+   (0xff << ((end) < 8*(byte) + 7 ? 8*(byte) + 7 - (end) : 0)) & 0xff)
+
+/** Rasterizes shape into mask, using bits (size bytes) for the bitmap.
+ *
+ *  \return The bytes used, or -1 if shape is larger than size bytes or
+ *  255 pixels in either direction
+ */
+int abMaskInit(AbMask *mask, const AbShape *shape, u_char *bits, int size);
+
+/** As required by AbShape
+ */
+void abMaskGetBounds(const AbMask *mask, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abMaskCheck(const AbMask *mask, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape
+ *
+ *  Rows with more than SHAPE_MAX_SPANS runs return -1.
+ */
+int abMaskRowSpans(const AbMask *mask, const Vec2 *centerPos, int row, Span *spans);
+
 /** Linked list of Layers.  
  * 
  *  Each layer contains
@@ -157,20 +270,42 @@ int abRectOutlineCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pi
  *   - the layer's current position
  *   - the layer's color
  *   - a reference to the next (lower) layer.
+ *   - flags (LAYER_*), may be omitted from initializers
+ *
+ *  shapeLib never writes a LAYER_STATIC layer, so scenery may be const
+ *  (kept in flash) and chained to from RAM layers with a cast:
+ *    const Layer lane = {(AbShape *)&laneShape, {64, 39}, {0,0}, {0,0},
+ *                        COLOR_BLACK, 0, LAYER_STATIC};
+ *    Layer car = {(AbShape *)&carShape, {0, 39}, {0,0}, {0,0},
+ *                 COLOR_RED, (Layer *)&lane};
  */
 typedef struct Layer_s {
-  AbShape *abShape;
+  const AbShape *abShape;
   Vec2 pos, posLast, posNext; /* initially just set pos */
   u_int color;
   struct Layer_s *next;
+  u_char flags;
 } Layer;	
 
+/** Layer flags */
+#define LAYER_TELEPORT 0x01	/* posNext was set by a jump, not a move */
+#define LAYER_DISCONTINUOUS 0x02 /* pos was reached from posLast by a jump */
+#define LAYER_STATIC 0x04	/* never moves or changes, see layerBgBuild */
+
 /** Compute layer's bounding box.
  */
 void layerGetBounds(const Layer *l, Region *bounds);
 
+/** Moves layer to posNext (posLast becomes the old pos).
+ *
+ *  A LAYER_TELEPORT flag set since the last commit becomes
+ *  LAYER_DISCONTINUOUS, so the old and new positions are redrawn as
+ *  separate regions rather than their bounding box.
+ */
+void layerCommit(Layer *l);
+
 /**
-  sets bounds into a consistent state
+  sets bounds into a consistent state (of the layers that aren't static)
  */
 void layerInit(Layer *layers);
 
@@ -179,6 +314,311 @@ void layerInit(Layer *layers);
  */
 void layerDraw(Layer *layers);
 
+/** Render the layers within region (bounds included).
+ *
+ *  Each row is resolved from the layers' spans into runs of a single
+ *  color, so shapes are not probed per pixel.  Output is identical to
+ *  probing every pixel with layerProbe.
+ */
+void layerDrawRegion(Layer *layers, const Region *region);
+
+/** Most layers whose bounds are computed once per draw.  Rows and
+ *  regions only probe the layers whose bounds reach them; layers past
+ *  this many (above the static background) are always probed.  Each one
+ *  costs 10 bytes of RAM; frogger has 4 (the frog and its cars).
+ */
+#define LAYER_CULL_MAX 4
+
+/** Render the layers within each of count regions, as layerDrawRegion.
+ *  Layer bounds are computed once for all of them.
+ */
+void layerDrawRegions(Layer *layers, const Region *regions, u_char count);
+
+/** Most bands (groups of rows with the same content) in the static
+ *  background table.  Rows past the last band are resolved as usual.
+ *  Each one costs 4 bytes of RAM; frogger's lanes and the rows above
+ *  them take 8.
+ */
+#define BG_MAX_BANDS 8
+
+/** Builds the static background table from the LAYER_STATIC layers at the
+ *  bottom (end) of layers.  Rows those layers cover with a single color
+ *  are then drawn without probing them.
+ *
+ *  Call again after changing a static layer.
+ */
+void layerBgBuild(Layer *layers);
+
+/** Color of the pixel at pixelPos:  the color of the first layer
+ *  containing it, or bgColor if no layer does.
+ */
+u_int layerProbe(Layer *layers, const Vec2 *pixelPos);
+
+/** Checks of abRectCheck, abRArrowCheck and abMaskCheck the compiler can
+ *  inline, for layers known at compile time (LAYER_STATIC_PROBE)
+ */
+static inline int
+abRectCheckInline(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int dCol = pixel->axes[0] - centerPos->axes[0];
+  int dRow = pixel->axes[1] - centerPos->axes[1];
+  return dCol >= -rect->halfSize.axes[0] && dCol <= rect->halfSize.axes[0]
+    && dRow >= -rect->halfSize.axes[1] && dRow <= rect->halfSize.axes[1];
+}
+
+static inline int
+abRArrowCheckInline(const AbRArrow *arrow, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int halfSize = arrow->size / 2;
+  int col = centerPos->axes[0] - pixel->axes[0]; /* leftwards from the tip */
+  int row = pixel->axes[1] - centerPos->axes[1];
+  row = (row >= 0) ? row : -row;
+  if (col < 0 || col > arrow->size)
+    return 0;
+  return (col <= halfSize) ? row <= col : row <= halfSize / 2;
+}
+
+static inline int
+abMaskCheckInline(const AbMask *mask, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int col = pixel->axes[0] - centerPos->axes[0] - mask->offset.axes[0];
+  int row = pixel->axes[1] - centerPos->axes[1] - mask->offset.axes[1];
+  if (col < 0 || col >= mask->width || row < 0 || row >= mask->height)
+    return 0;
+  return (mask->bits[row * ((mask->width + 7) >> 3) + (col >> 3)] >> (7 - (col & 7))) & 1;
+}
+
+/** Static dispatch:  layerProbe for a layer stack known at compile time.
+ *
+ *  The stack is an X-macro of LAYER(kind, shape, layer), top first:
+ *    #define GAME_LAYERS(LAYER) \
+ *      LAYER(abCircle, circle6, frogLayer) LAYER(abRect, laneShape, laneLayer)
+ *    LAYER_STATIC_PROBE(gameProbe, GAME_LAYERS)
+ *  defines u_int gameProbe(const Vec2 *pixelPos), testing each layer with
+ *  kind##CheckInline in order, so there are no calls through AbShape.
+ *  Kinds are abRect, abRArrow, abMask, and abCircle from abCircle.h.
+ *  Positions and colors are read from the layers as they are drawn.
+ */
+#define LAYER_STATIC_TEST(kind, shape, layer)				\
+  if (kind##CheckInline(&(shape), &(layer).pos, pixelPos))		\
+    return (layer).color;
+
+#define LAYER_STATIC_PROBE(name, LAYERS)				\
+  u_int name(const Vec2 *pixelPos)					\
+  {									\
+    LAYERS(LAYER_STATIC_TEST)						\
+    return bgColor;							\
+  }
+
+#ifdef SHAPE_STATS
+/** Pixels drawn by the layer compositor, counted until cleared (when
+ *  built with SHAPE_STATS)
+ */
+typedef struct {
+  unsigned long pixelsWritten;	/* sent to the lcd */
+  unsigned long pixelsProbed;	/* resolved by layerProbe, not from spans */
+} LayerStats;
+
+extern LayerStats layerStats;
+#endif
+
+/** Most distinct shapes in a LayerSet */
+#define LAYERSET_SHAPES 16
+
+/** Positions in a LayerSet are stored plus this, so a center may be up
+ *  to this far off the top or left of the screen
+ */
+#define LAYERSET_BIAS 64
+
+/** Compact layer store for scenes short on RAM:  parallel arrays, the
+ *  layer at index 0 on top, instead of a linked list of Layers.
+ *
+ *  A layer takes 5 bytes (a Layer takes 20):  its center as two biased
+ *  u_chars (see layerSetMove), an index into shapes and a color.
+ *  Centers are kept apart from the rest as they're read for every row.
+ *  There is no previous position:  callers redraw what they moved with
+ *  layerSetDrawRegion.
+ */
+typedef struct {
+  u_char count;			/* layers */
+  u_char *cols, *rows;		/* centers + LAYERSET_BIAS */
+  u_char *shapeIds;		/* index in shapes of each layer */
+  u_int *colors;
+  const AbShape *const *shapes;
+  u_char shapeCount;		/* at most LAYERSET_SHAPES */
+} LayerSet;
+
+/** Stored in cols for a layer centered out of range:  it isn't drawn */
+#define LAYERSET_HIDDEN 0xff
+
+/** Farthest a center may be right of or below the screen's origin */
+#define LAYERSET_MAX (LAYERSET_HIDDEN - 1 - LAYERSET_BIAS)
+
+#define layerSetCol(set, i) ((int)(set)->cols[i] - LAYERSET_BIAS)
+#define layerSetRow(set, i) ((int)(set)->rows[i] - LAYERSET_BIAS)
+#define layerSetHidden(set, i) ((set)->cols[i] == LAYERSET_HIDDEN)
+
+/** Center layer i of set at col, row.  Outside -LAYERSET_BIAS..LAYERSET_MAX
+ *  the layer is hidden rather than stored wrapped, so shapes must not
+ *  reach the screen from there.  Returns 0 if it was hidden.
+ */
+int layerSetMove(LayerSet *set, u_char i, int col, int row);
+
+/** Bounds of layer i of set, clipped to the screen */
+void layerSetGetBounds(const LayerSet *set, u_char i, Region *bounds);
+
+/** As layerProbe, for a LayerSet */
+u_int layerSetProbe(const LayerSet *set, const Vec2 *pixelPos);
+
+/** As layerDrawRegion, for a LayerSet.  Layers whose shape's rows miss
+ *  a row are skipped from the rows array before their shape is asked
+ *  for spans.
+ */
+void layerSetDrawRegion(const LayerSet *set, const Region *region);
+
+/** Render every layer of set over the whole screen */
+void layerSetDraw(const LayerSet *set);
+
+/** Most rectangles a DamageList holds.  A rectangle added to a full
+ *  list is merged into the one it wastes least with.  Each one costs 8
+ *  bytes of RAM; see bench/shapebench for what fewer cost in pixels.
+ */
+#ifndef DAMAGE_MAX_REGIONS
+#define DAMAGE_MAX_REGIONS 4
+#endif
+
+/** Free rectangles damageAddLayer wants before it damages a layer, and
+ *  damageAddLayerDelta before each row; with fewer, those held are drawn
+ *  and the list starts over, so merging a full list stays rare.
+ */
+#ifndef DAMAGE_LAYER_ROOM
+#define DAMAGE_LAYER_ROOM 2
+#endif
+
+/** Cost of opening an lcd area (lcd_setArea sends 11 bytes), in pixels.
+ *  Rectangles are merged when their bounding box redraws no more than
+ *  this many pixels that neither of them covers.
+ */
+#define DAMAGE_SETAREA_COST 8
+
+#ifdef SHAPE_STATS
+/** Pixel counts of a frame drawn by damageDraw (when built with
+ *  SHAPE_STATS), flushes of a full list included
+ */
+typedef struct {
+  u_int pixelsRaw;		/* pixels in the rectangles added */
+  u_int pixels;			/* pixels drawn after merging */
+  u_char regions;		/* rectangles drawn */
+} DamageStats;
+#endif
+
+/** The regions of the screen that must be redrawn this frame.
+ *
+ *  Rectangles are kept disjoint:  overlapping and adjacent rectangles
+ *  are merged when that is cheaper than drawing them separately,
+ *  otherwise the parts already covered are cut away.  Every damaged
+ *  pixel is drawn, and none twice between flushes of a full list;
+ *  merges also redraw undamaged pixels inside their bounding box.
+ */
+typedef struct {
+  Region regions[DAMAGE_MAX_REGIONS];
+  u_char count;
+  Layer *layers;		/* drawn from */
+#ifdef SHAPE_STATS
+  DamageStats added;		/* since the last damageDraw */
+  DamageStats frame;		/* counts for the last frame drawn */
+#endif
+} DamageList;
+
+/** Empties the damage list and clears its counts.  Damaged regions are
+ *  redrawn from layers.
+ */
+void damageInit(DamageList *damage, Layer *layers);
+
+/** Adds a (screen clipped) region to be redrawn.
+ */
+void damageAdd(DamageList *damage, const Region *region);
+
+/** Adds the region covered by a layer at posLast and pos.
+ *  Discontinuous moves add the two positions as separate regions.
+ */
+void damageAddLayer(DamageList *damage, const Layer *l);
+
+/** Adds only the pixels whose coverage by a layer changed between
+ *  posLast and pos:  for a sprite sliding a few pixels, the strip it
+ *  uncovered and the strip it moved onto.  Pixels the layer covers at
+ *  both positions are unchanged, so a layer whose color or shape changes
+ *  must be damaged with damageAddLayer instead.
+ */
+void damageAddLayerDelta(DamageList *damage, const Layer *l);
+
+/** Redraws the damaged regions and empties the damage list.
+ *  Counts for the frame are left in damage->frame (SHAPE_STATS builds).
+ */
+void damageDraw(DamageList *damage);
+
+/** Fraction bits of the fixed point (Q8.8) velocities of MovLayers */
+#define MOV_FRAC_BITS 8
+
+/** Pixels (a constant, which may have a fraction) in Q8.8:
+ *  MOV_Q8(2.5) moves two and a half pixels per advance.
+ */
+#define MOV_Q8(pixels) ((int)((pixels) * (1 << MOV_FRAC_BITS)))
+
+/** Linked list of moving layers.
+ *
+ *  velocity is for the program's advance functions, which set
+ *  layer->posNext (and LAYER_TELEPORT for jumps), typically from an
+ *  interrupt handler.  Advanced by movLayerStep it's in Q8.8 pixels, and
+ *  the layer's position is layer->posNext plus frac/256 pixels, so
+ *  speeds needn't be whole pixels per advance.  frac, last so that
+ *  initializers may leave it out, starts at 0.
+ */
+typedef struct MovLayer_s {
+  Layer *layer;
+  Vec2 velocity;
+  struct MovLayer_s *next;
+  u_char frac[2];		/* of each axis, in 1/256 pixels */
+} MovLayer;
+
+/** Adds movLayer's velocity to its fixed point position.  The whole
+ *  pixels go to newPos, for the caller to bounce or wrap and set as
+ *  posNext; the fraction stays in movLayer->frac.
+ *
+ *  \return True if newPos isn't posNext:  otherwise the layer hasn't
+ *  moved on screen and there's nothing to redraw.
+ */
+int movLayerStep(MovLayer *movLayer, Vec2 *newPos);
+
+/** Moves each of movLayers to its posNext (with interrupts off, so an
+ *  advance can't interleave) and redraws the pixels they uncovered or
+ *  newly covered within layers.  Pixel counts are added to layerStats.
+ */
+void movLayerDraw(MovLayer *movLayers, Layer *layers);
+
+/** Columns of the screen */
+#define LANEBITS_COLS screenWidth
+#define LANEBITS_WORDS ((LANEBITS_COLS + 15) / 16)
+
+/** Which columns of a lane (a band of rows things move along) were
+ *  swept in a step:  one bit per column, 16 to a word, so "did anything
+ *  cover columns start..end" is a masked test of a word or two however
+ *  many movers the lane has.  A step starts from a cleared lane with
+ *  the movers' spans set, then sets every column each one drives over.
+ */
+typedef struct {
+  u_int words[LANEBITS_WORDS];
+} LaneBits;
+
+/** Clears every column of lane */
+void laneBitsClear(LaneBits *lane);
+
+/** Marks columns start..end (clipped to the screen) swept */
+void laneBitsSet(LaneBits *lane, int start, int end);
+
+/** True if any of columns start..end (clipped to the screen) is swept */
+int laneBitsAny(const LaneBits *lane, int start, int end);
+
 /** Background color.
   */
 extern u_int bgColor;		/*  background color */